@@ -96,6 +96,21 @@ inline sptr<FilterGen<float, cfloat>> rfftplan_new(int n = -1)
   return tsdF::rtfrplan_création(n);
 }
 
+/** @brief Creation of an inverse FFT plan, for real output signals.
+ *
+ *  The input is the complete spectrum (n points, assumed hermitian symmetric),
+ *  and only the first @f$n/2+1@f$ points are used.
+ *
+ *  @param n  Vector dimension (optional parameter)
+ *  @return A %Filter from @ref cfloat to float.
+ *
+ *  @sa rfftplan_new(), ifft()
+ */
+inline sptr<FilterGen<cfloat, float>> irfftplan_new(int n = -1)
+{
+  return tsdF::irtfrplan_création(n);
+}
+
 
 /** @brief FFT of a real vector.
  *
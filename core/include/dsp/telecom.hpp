@@ -770,6 +770,38 @@ inline sptr<Filter<cfloat,cfloat,nfr::DSSSConfig>> dsss_modulation(const DSSSCon
 }
 
 
+/** @brief Polyphase filter bank configuration (channelizer / synthesizer) */
+using PFBConfig = nfr::CanaliseurPFBConfig;
+
+/** @brief Streaming channelizer: one signal to M channels */
+using PFBChannelizer = nfr::CanaliseurPFB;
+
+/** @brief Streaming synthesizer: M channels to one signal */
+using PFBSynthesizer = nfr::SynthétiseurPFB;
+
+/** @brief Polyphase channelizer (analysis filter bank, Harris method)
+ *
+ *  Channel k is the input signal shifted from frequency @f$k/M@f$ down to 0,
+ *  filtered by the prototype, and decimated by M (or M/2 if oversampled).
+ *  Output: one row per output instant, one column per channel.
+ *
+ *  @sa pfb_synthesizer()
+ */
+inline sptr<PFBChannelizer> pfb_channelizer(const PFBConfig &config)
+{
+  return nfr::canaliseur_pfb(config);
+}
+
+/** @brief Polyphase synthesizer (synthesis filter bank), inverse of pfb_channelizer()
+ *
+ *  @sa pfb_channelizer()
+ */
+inline sptr<PFBSynthesizer> pfb_synthesizer(const PFBConfig &config)
+{
+  return nfr::synthétiseur_pfb(config);
+}
+
+
 /** @brief Baseband downconversion configuration. */
 struct TranspoBBConfig: nfr::TranspoBBConfig
 {
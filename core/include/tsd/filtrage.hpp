@@ -809,6 +809,22 @@ extern Vecf design_rif_eq(entier n, const vector<SpecFreqIntervalle> &spec);
  */
 extern Vecf design_rif_demi_bande(int n, float fc);
 
+/** @brief Design conjoint d'une cascade de filtres demi-bande (décimation / interpolation d'un facteur @f$2^k@f$)
+ *
+ *  L'étage @f$s@f$ (@f$s = 0@f$ : fréquence d'échantillonnage la plus élevée) fonctionne à @f$2^{k-s}@f$ fois
+ *  la fréquence la plus basse : sa bande passante est @f$f_p = f_c / 2^{k-s}@f$,
+ *  et seules les fréquences supérieures à @f$1/2 - f_p@f$ (qui se replient sur @f$[0, f_p]@f$) doivent être atténuées.
+ *  Pour chaque étage, le nombre de coefficients (de la forme @f$4P-1@f$) est le plus petit permettant d'atteindre l'atténuation demandée.
+ *
+ *  @param k         Nombre d'étages
+ *  @param fc        Fin de la bande utile, normalisée par rapport à la fréquence la plus basse (entre 0 et 0,5)
+ *  @param atten_db  Atténuation minimale (dB)
+ *  @returns         Coefficients des @f$k@f$ étages (du plus rapide au plus lent)
+ *
+ *  @sa design_rif_demi_bande(), filtre_rif_demi_bande_cascade()
+ */
+extern vector<Vecf> design_rif_demi_bande_cascade(entier k, float fc, float atten_db = 60);
+
 
 
 /** @brief Différentiateur numérique (approximation RIF).
@@ -1020,7 +1036,7 @@ struct CICConfig
   /** @brief Number of integrators / differentiators */
   entier N = 1;
 
-  /** @brief Design parameter (typically M=1) */
+  /** @brief Differential delay (typically M=1 or M=2) */
   entier M = 1;
 };
 
@@ -1362,11 +1378,124 @@ extern sptr<Filtre<float, cfloat, HilbertTransformeurConfig>>
  *  @note Si le filtre a un nombre important de coefficients, utilisez plutôt @ref filtre_rif_fft(), qui sera plus efficace
  *  (filtrage dans le domaine fréquentiel).
  *
+ *  @note Les coefficients symétriques ou anti-symétriques (filtres à phase linéaire, comme ceux issus
+ *  de design_rif_fen(), design_rif_eq() ou design_rif_rcs()) sont détectés automatiquement :
+ *  les paires d'échantillons partageant le même coefficient sont alors pré-additionnées,
+ *  ce qui divise par deux le nombre de multiplications.
+ *
  *  @sa filtre_rif_fft()
  */
 template<typename Tc, typename T = Tc>
   sptr<FiltreGen<T>> filtre_rif(const Vecteur<Tc> &h);
 
+/** @brief Interface abstraite pour un traitement identique de plusieurs canaux
+ *
+ *  Les signaux sont passés sous forme de tableaux 2d : un canal par colonne.
+ *
+ *  @sa filtre_rif_multi()
+ */
+template<typename T>
+struct FiltreMultiCanaux
+{
+  virtual ~FiltreMultiCanaux(){}
+
+  /** @brief Traitement d'un bloc de données
+   *  @param x  Signaux d'entrée (n échantillons x nombre de canaux)
+   *  @param y  Signaux de sortie (mêmes dimensions)
+   */
+  virtual void step(const TabT<T,2> &x, TabT<T,2> &y) = 0;
+
+  /** @brief Traitement d'un bloc de données
+   *  @param x  Signaux d'entrée (n échantillons x nombre de canaux)
+   *  @returns  Signaux de sortie (mêmes dimensions)
+   */
+  TabT<T,2> step(const TabT<T,2> &x)
+  {
+    TabT<T,2> y;
+    step(x, y);
+    retourne y;
+  }
+};
+
+/** @brief Banc de filtres RIF identiques, pour plusieurs canaux
+ *
+ *  Équivalent à une instance de filtre_rif() par canal, mais les lignes à retard des différents canaux
+ *  sont entrelacées : chaque coefficient chargé est appliqué simultanément à plusieurs canaux (registres SIMD),
+ *  et les coefficients ne sont parcourus qu'une fois pour tous les canaux.
+ *
+ *  @param h          Vecteur des coefficients du filtre (réels, ou complexes pour des données complexes)
+ *  @param nb_canaux  Nombre de canaux (nombre de colonnes des tableaux d'entrée)
+ *  @param nb_groupes Nombre de groupes de canaux, chaque groupe ayant sa propre ligne à retard.
+ *                    Les groupes sont traités en parallèle si OpenMP est activé (LIBTSD_USE_OMP).
+ *  @tparam Tc Type des coefficients
+ *  @tparam T  Type des données (float ou cfloat)
+ *  @return Un bloc @ref FiltreMultiCanaux, traitant des tableaux (n échantillons x nb_canaux)
+ *
+ *  @par Exemple
+ *  @code
+ *  soit h = design_rif_fen(63, "lp", 0.1);
+ *  soit f = filtre_rif_multi<float, cfloat>(h, 32);
+ *  Tabcf x = ...; // 32 colonnes (une par antenne)
+ *  soit y = f->step(x);
+ *  @endcode
+ *
+ *  @sa filtre_rif()
+ */
+template<typename Tc, typename T = Tc>
+  sptr<FiltreMultiCanaux<T>> filtre_rif_multi(const Vecteur<Tc> &h, entier nb_canaux, entier nb_groupes = 1);
+
+/** @cond undoc */
+// Noyaux RIF par bloc (filtre-rt.cc), partagés avec les structures polyphase et multi-canaux.
+// S = 1 : données réelles, S = 2 : données complexes entrelacées, S > 2 : canaux entrelacés.
+
+// y[i] (+)= somme_{k < K} h[k] x[i + S.k], i < m
+extern void rif_bloc(const float *h, entier K, const float *x, float *y, entier m,
+                     entier S, bouléen accumule);
+// y[i] += somme_{k < Q} h[k] (a[i + S.k] ± b[i - S.k]), i < m
+extern void rif_bloc_replié(const float *h, entier Q, const float *a, const float *b,
+                            float *y, entier m, entier S, bouléen anti);
+// 1 : coefficients symétriques, -1 : anti-symétriques, 0 : quelconques
+extern entier rif_symétrie(const Vecf &h);
+extern entier rif_symétrie(const Veccf &h);
+// Première moitié des coefficients (coefficient central divisé par deux si symétrique)
+extern Vecf  rif_coefs_repliés(const Vecf &h, entier symétrie);
+extern Veccf rif_coefs_repliés(const Veccf &h, entier symétrie);
+// Coefficients des sections de filtre_sois() (une colonne par section : b0, b1, b2, a1, a2),
+// section du premier ordre et gain compris
+extern Tabd sois_coefs(const FRat<cfloat> &h);
+extern Tabd sois_coefs(const FRat<float> &h);
+
+// somme_{k < K} h[k] w[k], à partir des coefficients repliés hr
+template<typename T, typename Tc>
+  T rif_produit_replié(const Tc *hr, const T *w, entier K, entier symétrie)
+{
+  soit Q = (symétrie > 0) ? (K + 1) / 2 : K / 2;
+  T s0 = 0, s1 = 0;
+  entier k = 0;
+  si(symétrie > 0)
+  {
+    pour(; k + 2 <= Q; k += 2)
+    {
+      s0 += (w[k]   + w[K-1-k]) * hr[k];
+      s1 += (w[k+1] + w[K-2-k]) * hr[k+1];
+    }
+    pour(; k < Q; k++)
+      s0 += (w[k] + w[K-1-k]) * hr[k];
+  }
+  sinon
+  {
+    pour(; k + 2 <= Q; k += 2)
+    {
+      s0 += (w[k]   - w[K-1-k]) * hr[k];
+      s1 += (w[k+1] - w[K-2-k]) * hr[k+1];
+    }
+    pour(; k < Q; k++)
+      s0 += (w[k] - w[K-1-k]) * hr[k];
+  }
+  retourne s0 + s1;
+}
+/** @endcond */
+
 
 
 /** @brief Filtre identité.
@@ -1392,15 +1521,159 @@ template<typename T>
  *  est important (de l'ordre de @f$\log M@f$ opérations par échantillon au lieu de @f$M@f$).
  *
  *  @param h Vecteur des coefficients du filtre
+ *  @param dim_bloc Dimension @f$N_e@f$ des blocs temporels (0 : valeur par défaut, 512).
+ *  Il faut @f$N_f - N_e \leq N_e@f$, @f$N_f@f$ étant la dimension de la TFR (puissance de 2 supérieure ou égale à @f$N_e + M@f$).
  *  @tparam T Type de données à traiter
  *  @return %Filtre T -> T
  *
- *  @note Notez que cette technique introduit un délais un peu plus important que l'implémentation temporelle.
+ *  @note Notez que cette technique introduit un délais un peu plus important que l'implémentation temporelle
+ *  (le flux de sortie est retardé de @f$N_e - M@f$ échantillons).
+ *  Pour une faible latence, voir filtre_rif_partition().
  *
- *  @sa filtre_rif()
+ *  @sa filtre_rif(), filtre_rif_partition(), filtre_rif_auto()
+ */
+template<typename T>
+  sptr<FiltreGen<T>> filtre_rif_fft(const Vecf &h, entier dim_bloc = 0);
+
+/** @brief Filtre RIF par TFR à faible latence (convolution partitionnée)
+ *
+ *  Ce bloc réalise un filtrage RIF par la technique overlap-save, le filtre étant découpé
+ *  en @f$P = \lceil M / B\rceil@f$ partitions de @f$B@f$ coefficients, dont les spectres sont pré-calculés
+ *  (TFR de dimension @f$2B@f$). Les spectres des @f$P@f$ derniers blocs d'entrée sont conservés
+ *  (ligne à retard fréquentielle), et pour chaque nouveau bloc :
+ *  @f[
+ *  Y_b = \sum_{p=0}^{P-1} H_p \cdot X_{b-p}
+ *  @f]
+ *
+ *  La latence est donc d'une seule partition (@f$B@f$ échantillons), indépendamment du nombre de coefficients,
+ *  alors que pour filtre_rif_fft(), elle est d'un bloc complet (au moins @f$M@f$ échantillons).
+ *
+ *  En mode non uniforme, seuls les premiers coefficients sont traités avec des partitions de dimension @f$B@f$,
+ *  les suivants étant traités par des partitions de plus en plus grandes (@f$4B@f$, @f$16B@f$, ...),
+ *  ce qui réduit le coût pour les filtres très longs (au-delà de quelques milliers de coefficients),
+ *  sans changer la latence.
+ *
+ *  @param h               Vecteur des coefficients du filtre
+ *  @param dim_partition   Dimension @f$B@f$ des partitions (latence, en échantillons)
+ *  @param non_uniforme    Si vrai, partitions non uniformes (voir ci-dessus)
+ *  @tparam T Type de données à traiter (float ou cfloat)
+ *  @return %Filtre T -> T
+ *
+ *  @note Seuls les blocs complets de @f$B@f$ échantillons sont produits en sortie
+ *  (si la dimension des vecteurs d'entrée est un multiple de @f$B@f$, la sortie a la même dimension que l'entrée).
+ *  Le flux de sortie n'est pas retardé par rapport à l'implémentation directe.
+ *
+ *  @note Les plans de TFR utilisés partagent les tables du cache TFR (voir tfr_cache_stats()).
+ *
+ *  @sa filtre_rif(), filtre_rif_fft(), filtre_rif_auto()
  */
 template<typename T>
-  sptr<FiltreGen<T>> filtre_rif_fft(const Vecf &h);
+  sptr<FiltreGen<T>> filtre_rif_partition(const Vecf &h, entier dim_partition = 64, bouléen non_uniforme = non);
+
+
+/** @brief Implémentation d'un filtre RIF, choisie par filtre_rif_auto() */
+struct RIFImplémentation
+{
+  /** @brief Type d'implémentation */
+  enum Type
+  {
+    /** @brief Implémentation directe (filtre_rif()) */
+    DIRECTE = 0,
+    /** @brief Par TFR, technique OLA (filtre_rif_fft()) */
+    OLA,
+    /** @brief Par TFR, convolution partitionnée (filtre_rif_partition()) */
+    PARTITIONNÉE
+  } type = DIRECTE;
+
+  /** @brief Dimension des blocs temporels (OLA) ou des partitions, 0 sinon */
+  entier dim_bloc = 0;
+
+  /** @brief Latence (en échantillons) : nombre d'échantillons d'entrée à accumuler avant qu'une sortie ne soit produite */
+  entier latence = 0;
+
+  /** @brief Retard du flux de sortie (en échantillons) par rapport à l'implémentation directe */
+  entier retard = 0;
+
+  /** @brief Coût estimé (ns / échantillon) */
+  float coût = 0;
+};
+
+/** @brief Profil de calibration du choix d'implémentation RIF (voir rif_calibration())
+ *
+ *  Coûts mesurés (ou estimés) sur la machine courante. */
+struct RIFProfil
+{
+  /** @brief Implémentation directe, données réelles (ns / coefficient / échantillon) */
+  float ns_coef_réel = 0.035f;
+
+  /** @brief Implémentation directe, données complexes (ns / coefficient / échantillon) */
+  float ns_coef_complexe = 0.07f;
+
+  /** @brief Facteur de coût de l'implémentation directe, coefficients symétriques */
+  float facteur_symétrique = 0.9f;
+
+  /** @brief OLA (ns / opération, au sens de ola_complexité()) */
+  float ns_flop_tfr = 0.15f;
+
+  /** @brief Convolution partitionnée (ns / opération, TFR et produits fréquentiels) */
+  float ns_flop_partition = 0.15f;
+
+  /** @brief Vrai si le profil est issu d'une mesure (sinon, valeurs par défaut) */
+  bouléen calibré = non;
+};
+
+/** @brief Profil de calibration courant
+ *
+ *  Au premier appel, le profil est lu depuis le fichier local (variable d'environnement @p TSD_PROFIL_RIF,
+ *  ou à défaut <tt>$HOME/.tsd/profil-rif.txt</tt>), s'il existe. Sinon, des valeurs par défaut sont utilisées.
+ *
+ *  @sa rif_calibration(), filtre_rif_auto() */
+extern RIFProfil rif_profil();
+
+/** @brief Calibration du choix d'implémentation RIF pour la machine courante
+ *
+ *  Mesure (micro-benchmark, quelques dizaines de ms) le coût des implémentations directe, OLA et partitionnée,
+ *  met à jour le profil courant, et l'enregistre dans le fichier local (voir rif_profil()).
+ *  Il suffit de l'appeler une fois par machine.
+ *
+ *  @param sauve Si vrai, enregistre le profil dans le fichier local.
+ *  @returns Le nouveau profil
+ *
+ *  @sa rif_profil(), filtre_rif_auto() */
+extern RIFProfil rif_calibration(bouléen sauve = oui);
+
+/** @brief Choix de l'implémentation la moins coûteuse pour un filtre RIF
+ *
+ *  @param K                 Nombre de coefficients
+ *  @param dim_bloc_typique  Dimension typique des blocs passés au filtre (0 si inconnue)
+ *  @param latence_max       Latence maximale admissible, en échantillons (-1 : pas de contrainte)
+ *  @param complexe          Vrai si les données sont complexes
+ *  @param symétrique        Vrai si les coefficients sont symétriques ou anti-symétriques
+ *  @param profil            Profil de coût (voir rif_profil())
+ *
+ *  @sa filtre_rif_auto() */
+extern RIFImplémentation rif_choix_implémentation(entier K, entier dim_bloc_typique, entier latence_max,
+                                                   bouléen complexe, bouléen symétrique,
+                                                   const RIFProfil &profil = rif_profil());
+
+/** @brief Filtre RIF, avec choix automatique de l'implémentation (directe, ou par TFR : OLA ou partitionnée)
+ *
+ *  L'implémentation la moins coûteuse (voir rif_choix_implémentation()) est choisie,
+ *  à partir du nombre de coefficients, de la dimension typique des blocs et de la latence admissible,
+ *  d'après un modèle de coût calibrable une fois par machine (rif_calibration()).
+ *
+ *  @param h                 Vecteur des coefficients du filtre
+ *  @param dim_bloc_typique  Dimension typique des blocs passés au filtre (0 si inconnue)
+ *  @param latence_max       Latence maximale admissible, en échantillons (-1 : pas de contrainte, 0 : implémentation directe)
+ *  @param[out] choix        Si non nul, implémentation choisie (en particulier, retard du flux de sortie)
+ *  @tparam T Type de données à traiter (float ou cfloat)
+ *  @return %Filtre T -> T
+ *
+ *  @sa filtre_rif(), filtre_rif_fft(), filtre_rif_partition(), rif_calibration()
+ */
+template<typename T>
+  sptr<FiltreGen<T>> filtre_rif_auto(const Vecf &h, entier dim_bloc_typique = 0, entier latence_max = -1,
+                                     RIFImplémentation *choix = nullptr);
 
 
 
@@ -1441,8 +1714,16 @@ template<typename Tc, typename T = Tc>
  *
  *
  *
- *  @note Pour le type interne, il faut absolument choisir un type entier, car la façon dont le filtre est
- *  implémenté fait que les calculs ne fonctionneront pas avec un type flottant.
+ *  Le filtre fonctionne au fil de l'eau : les registres des intégrateurs et des peignes,
+ *  ainsi que la phase de décimation, sont conservés d'un appel à l'autre.
+ *  Tous les étages sont calculés en une seule passe, en arithmétique modulaire :
+ *  les débordements des intégrateurs sont sans effet sur la sortie, à condition que le type interne
+ *  compte au moins @f$N \log_2(RM) + B_{in}@f$ bits (@f$B_{in}@f$ : nombre de bits du signal d'entrée).
+ *  Le retard différentiel M est quelconque (typiquement 1 ou 2).
+ *
+ *  @note Pour le type interne, il faut absolument choisir un type entier (entier ou int64_t),
+ *  car la façon dont le filtre est implémenté fait que les calculs ne fonctionneront pas avec un type flottant.
+ *  Les échantillons d'entrée sont convertis (par troncature) vers ce type.
  *
  *
  *  @par Exemple pour l'interpolation
@@ -1589,6 +1870,167 @@ template<typename T>
 template<typename T>
   sptr<FiltreGen<T>> filtre_sois(const FRat<float> &h, RIIStructure structure = FormeDirecte2);
 
+/** @brief Filtre RII par bloc (représentation d'état), équivalent à @ref filtre_sois()
+ *
+ *  La chaine de sections du second ordre est vue comme un seul système d'état
+ *  (dimension N = 2 par section, 4 en forme directe I) :
+ *  @f[
+ *  s_{n+1} = A s_n + B x_n,\quad y_n = C s_n + D x_n
+ *  @f]
+ *  Les échantillons sont traités par blocs de L, à l'aide de matrices pré-calculées
+ *  (@f$C A^i@f$, @f$A^L@f$, @f$A^i B@f$ et réponse impulsionnelle) :
+ *  @f[
+ *  y_{n+i} = C A^i s_n + \sum_{j \leq i} h_{i-j} x_{n+j},\quad s_{n+L} = A^L s_n + \sum_j A^{L-1-j} B x_{n+j}
+ *  @f]
+ *  Ainsi, il n'y a plus de dépendance d'un échantillon au précédent à l'intérieur d'un bloc, et tous les
+ *  calculs sont vectorisés (au prix d'environ 2N + L/2 + N²/L multiplications par échantillon).
+ *
+ *  Les sorties sont identiques (aux erreurs d'arrondi près) à celles de @ref filtre_sois()
+ *  (mêmes sections, même structure, même initialisation de l'état avec le premier échantillon).
+ *
+ *  @param h          Fonction de transfert
+ *  @param structure  RIIStructure::FormeDirecte1 ou RIIStructure::FormeDirecte2
+ *  @param dim_bloc   Dimension des blocs L (si 0, choisie automatiquement d'après l'ordre du filtre)
+ *  @return %Filtre T -> T
+ *
+ *  @sa filtre_sois(), filtre_rii_bloc()
+ */
+template<typename T>
+  sptr<FiltreGen<T>> filtre_sois_bloc(const FRat<cfloat> &h, RIIStructure structure = FormeDirecte2, entier dim_bloc = 0);
+
+template<typename T>
+  sptr<FiltreGen<T>> filtre_sois_bloc(const FRat<float> &h, RIIStructure structure = FormeDirecte2, entier dim_bloc = 0);
+
+/** @brief Filtre RII par bloc (représentation d'état), équivalent à @ref filtre_rii()
+ *
+ *  Même principe que @ref filtre_sois_bloc(), à partir des coefficients de la forme directe I
+ *  (état initial nul, comme @ref filtre_rii()).
+ *
+ *  @sa filtre_rii(), filtre_sois_bloc()
+ */
+template<typename Tc, typename T = Tc>
+  sptr<FiltreGen<T>> filtre_rii_bloc(const FRat<Tc> &h, entier dim_bloc = 0);
+
+/** @brief Statistiques d'un filtre virgule fixe (pour le dimensionnement des formats)
+ *
+ *  @sa FiltreFixe
+ */
+struct FiltreFixeStats
+{
+  /** @brief Valeur absolue maximale atteinte par l'accumulateur (avant arrondi) */
+  int64_t max_abs_acc = 0;
+  /** @brief Valeur absolue maximale des sorties (après saturation) */
+  int64_t max_abs_sortie = 0;
+  /** @brief Nombre de saturations (sorties, et sorties intermédiaires des sections RII) */
+  int64_t nb_saturations = 0;
+  /** @brief Nombre d'échantillons de sortie produits */
+  int64_t nb_échantillons = 0;
+};
+
+/** @brief Interface pour un filtre en virgule fixe
+ *
+ *  Les échantillons d'entrée et de sortie sont au même format :
+ *  Q15 (T = int16_t, accumulateur 32 bits) ou Q31 (T = int32_t, accumulateur 64 bits).
+ *  Les coefficients sont quantifiés sur le même nombre de bits que les échantillons,
+ *  avec @ref nb_bits_frac bits fractionnaires.
+ *  Chaque sortie est obtenue par arrondi au plus proche de l'accumulateur, puis saturation.
+ *
+ *  @sa filtre_rif_fixe(), filtre_rif_decim_fixe(), filtre_sois_fixe(), vers_fixe(), depuis_fixe()
+ */
+template<typename T>
+struct FiltreFixe
+{
+  /** @brief Nombre de bits fractionnaires des coefficients (première section pour un filtre RII) */
+  entier nb_bits_frac = 0;
+
+  /** @brief Statistiques, cumulées depuis la création ou le dernier appel à raz_stats() */
+  FiltreFixeStats stats;
+
+  virtual ~FiltreFixe(){}
+
+  /** @brief Traitement d'un bloc de données (en place possible)
+   *  @param x Échantillons d'entrée
+   *  @param y Échantillons de sortie (au moins dim_sortie_max(x.size()) éléments)
+   *  @returns Nombre d'échantillons produits */
+  virtual std::size_t step(std::span<const T> x, std::span<T> y) = 0;
+
+  /** @brief Nombre maximal d'échantillons produits pour n échantillons d'entrée */
+  virtual entier dim_sortie_max(entier n) const = 0;
+
+  /** @brief Remise à zéro des statistiques */
+  void raz_stats()
+  {
+    stats = FiltreFixeStats();
+  }
+};
+
+/** @brief Filtre RIF en virgule fixe (Q15 ou Q31)
+ *
+ *  Équivalent à @ref filtre_rif(), avec des multiplications-accumulations entières vectorisées
+ *  (en Q15, instruction pmaddwd : deux coefficients par instruction et par sortie).
+ *
+ *  Le nombre de bits fractionnaires des coefficients est choisi (si nb_bits_frac < 0) le plus grand possible,
+ *  tel que l'accumulateur ne puisse pas déborder :
+ *  @f[
+ *  \sum_k |h_k| \cdot 2^f < 2^{A - B}
+ *  @f]
+ *  (A : nombre de bits de l'accumulateur, B : nombre de bits des échantillons).
+ *  Seule la sortie peut donc saturer (compteur FiltreFixeStats::nb_saturations).
+ *
+ *  @param h            Coefficients du filtre
+ *  @param nb_bits_frac Nombre de bits fractionnaires des coefficients (si négatif : choix automatique)
+ *  @tparam T           int16_t (Q15) ou int32_t (Q31)
+ *
+ *  @par Exemple
+ *  @code
+ *  soit h = design_rif_fen(63, "lp", 0.1);
+ *  soit f = filtre_rif_fixe<int16_t>(h);
+ *  vector<int16_t> x(n), y(n);
+ *  vers_fixe<int16_t>(std::span<const float>(xf.data(), n), x);
+ *  f->step(x, y);
+ *  msg("Saturations : {}", f->stats.nb_saturations);
+ *  @endcode
+ *
+ *  @sa filtre_rif(), filtre_rif_decim_fixe(), FiltreFixe
+ */
+template<typename T>
+  sptr<FiltreFixe<T>> filtre_rif_fixe(const Vecf &h, entier nb_bits_frac = -1);
+
+/** @brief Filtre RIF avec décimation, en virgule fixe (Q15 ou Q31)
+ *
+ *  Équivalent à @ref filtre_rif_decim() (implémentation polyphase),
+ *  mêmes formats que @ref filtre_rif_fixe().
+ *
+ *  @sa filtre_rif_decim(), filtre_rif_fixe()
+ */
+template<typename T>
+  sptr<FiltreFixe<T>> filtre_rif_decim_fixe(const Vecf &h, entier R, entier nb_bits_frac = -1);
+
+/** @brief Chaine de sections du second ordre en virgule fixe (Q15 ou Q31)
+ *
+ *  Mêmes sections que @ref filtre_sois(), en forme directe I (accumulateur 64 bits, état initial nul).
+ *  Les coefficients de chaque section ont au plus B - 2 bits fractionnaires (@f$|a_1| < 2@f$).
+ *  Les gains sont répartis entre les sections de manière à ce que le gain maximal de la chaine,
+ *  jusqu'à chaque section intermédiaire, soit unitaire.
+ *
+ *  @sa filtre_sois(), FiltreFixe
+ */
+template<typename T>
+  sptr<FiltreFixe<T>> filtre_sois_fixe(const FRat<cfloat> &h, entier nb_bits_frac = -1);
+
+template<typename T>
+  sptr<FiltreFixe<T>> filtre_sois_fixe(const FRat<float> &h, entier nb_bits_frac = -1);
+
+/** @brief Conversion flottant vers virgule fixe (arrondi au plus proche et saturation)
+ *  @param nb_bits_frac Nombre de bits fractionnaires (si négatif : 15 pour int16_t, 31 pour int32_t) */
+template<typename T>
+  void vers_fixe(std::span<const float> x, std::span<T> y, entier nb_bits_frac = -1);
+
+/** @brief Conversion virgule fixe vers flottant
+ *  @param nb_bits_frac Nombre de bits fractionnaires (si négatif : 15 pour int16_t, 31 pour int32_t) */
+template<typename T>
+  void depuis_fixe(std::span<const T> x, std::span<float> y, entier nb_bits_frac = -1);
+
 /** @brief %Filtre RII du premier ordre (dit "RC numérique")
  *
  *  Ce filtre, dit "RC numérique", ou "filtre exponentiel", est un des filtres les plus simples, puisqu'il est
@@ -1764,6 +2206,60 @@ template<typename T>
   return filtrer(h, filtrer<T>(h,x).reverse()).reverse();
 }
 
+/** @brief Filtrage zéro-phase (bi-directionnel), par blocs traités en parallèle (filtre RII)
+ *
+ *  Même résultat que @ref filtfilt(const Design &, const Vecteur<T> &) (aux erreurs d'arrondi près),
+ *  pour des signaux de grande dimension :
+ *  le signal est découpé en blocs, filtrés indépendamment (aller, puis retour) sur plusieurs threads.
+ *  Chaque bloc est étendu de part et d'autre par une marge suffisante pour que le régime transitoire
+ *  du filtre RII ait disparu (durée calculée d'après la décroissance de @f$A^n@f$,
+ *  @f$A@f$ étant la matrice d'état du filtre), si bien que les blocs se raccordent sans discontinuité.
+ *  L'implémentation par bloc @ref filtre_sois_bloc() est utilisée pour chaque passe.
+ *
+ *  La version sur std::span peut travailler en place (y et x pointant sur la même zone mémoire,
+ *  par exemple un fichier projeté en mémoire) : seules les marges des blocs sont copiées,
+ *  en plus d'un tampon de travail par bloc (au plus @f$2^{20}@f$ échantillons plus les marges).
+ *
+ *  @param h          Fonction de transfert
+ *  @param x          Signal à filtrer
+ *  @param y          Signal filtré (même dimension que x, éventuellement la même zone mémoire)
+ *  @param nb_threads Nombre de threads (si 0 : nombre de coeurs)
+ *
+ *  @sa filtfilt_rif(), filtre_sois_bloc()
+ */
+template<typename T>
+  void filtfilt(const FRat<float> &h, std::span<const T> x, std::span<T> y, entier nb_threads = 0);
+
+/** @brief Filtrage zéro-phase par blocs parallèles (filtre RII, sous forme pôles / zéros,
+ *  par exemple issu de @ref design_riia()), voir
+ *  @ref filtfilt(const FRat<float> &, std::span<const T>, std::span<T>, entier) */
+template<typename T>
+  void filtfilt(const FRat<cfloat> &h, std::span<const T> x, std::span<T> y, entier nb_threads = 0);
+
+/** @brief Filtrage zéro-phase par blocs parallèles (filtre RII), voir
+ *  @ref filtfilt(const FRat<float> &, std::span<const T>, std::span<T>, entier) */
+template<typename T, typename Tc>
+  Vecteur<T> filtfilt(const FRat<Tc> &h, const Vecteur<T> &x, entier nb_threads = 0);
+
+/** @brief Filtrage zéro-phase par blocs parallèles (filtre RIF)
+ *
+ *  Identique à @ref filtfilt(const FRat<float> &, std::span<const T>, std::span<T>, entier),
+ *  pour un filtre RIF : les marges sont de K - 1 échantillons,
+ *  et le résultat est le même que celui du filtrage séquentiel.
+ *
+ *  @param h          Coefficients du filtre
+ *  @param x          Signal à filtrer
+ *  @param y          Signal filtré (même dimension que x, éventuellement la même zone mémoire)
+ *  @param nb_threads Nombre de threads (si 0 : nombre de coeurs)
+ */
+template<typename T>
+  void filtfilt_rif(const Vecf &h, std::span<const T> x, std::span<T> y, entier nb_threads = 0);
+
+/** @brief Filtrage zéro-phase par blocs parallèles (filtre RIF), voir
+ *  @ref filtfilt_rif(const Vecf &, std::span<const T>, std::span<T>, entier) */
+template<typename T>
+  Vecteur<T> filtfilt_rif(const Vecf &h, const Vecteur<T> &x, entier nb_threads = 0);
+
 /*template<typename T, typename Tc>
   Vecteur<T> filtfilt(const Vecteur<Tc> &h, const Vecteur<T> &x)
 {
@@ -1869,16 +2365,47 @@ struct InterpolateurRIF: Interpolateur<T>
    */
   virtual Vecf coefs(float τ) = 0;
 
+  /** @brief Calcul des coefficients, sans allocation.
+   *
+   *  Ecrit les @f$K@f$ coefficients correspondant au délais @f$\tau@f$ dans le tableau @p h
+   *  (mêmes coefficients que coefs()).
+   *  L'implémentation par défaut recopie le résultat de coefs() ; les interpolateurs de la librairie
+   *  la redéfinissent de manière à ne faire aucune allocation, ce qui permet de l'appeler à chaque échantillon
+   *  (récupération d'horloge, adaptation de rythme).
+   *
+   *  @param τ Retard fractionnaire, entre 0 et 1.
+   *  @param h Tableau de sortie (au moins @f$K@f$ éléments).
+   */
+  virtual void coefs_into(float τ, float *h)
+  {
+    soit c = coefs(τ);
+    assertion(c.rows() == this->K);
+    pour(auto i = 0; i < this->K; i++)
+      h[i] = c(i);
+  }
+
   // k : index de l'échantillon le plus ancien
   T step(const Vecteur<T> &x, entier k, float τ)
   {
-    soit h = coefs(τ);
-    assertion(h.rows() == this->K);
+    soit K = this->K;
+    si(h_tampon.rows() != K)
+      h_tampon.resize(K);
+    coefs_into(τ, h_tampon.data());
+    k %= K;
+    // Fenêtre circulaire : x(k) ... x(K-1), puis x(0) ... x(k-1)
+    soit h = h_tampon.data();
+    soit xp = x.data();
     T res = 0;
-    Pour(auto i = 0; i < this->K; i++)
-      res += h(i) * x((i + k) % this->K);
+    pour(auto i = 0; i < K - k; i++)
+      res += h[i] * xp[k + i];
+    pour(auto i = K - k; i < K; i++)
+      res += h[i] * xp[i - (K - k)];
     retourne res;
   }
+
+protected:
+  /** @brief Coefficients pour le dernier appel à step() (pas d'allocation par échantillon). */
+  Vecf h_tampon;
 };
 
 
@@ -1943,6 +2470,50 @@ template<typename T>
   sptr<InterpolateurRIF<T>> itrp_sinc(const InterpolateurSincConfig &config = InterpolateurSincConfig());
 
 
+/** @brief Structure de configuration pour un interpolateur de Farrow. */
+struct InterpolateurFarrowConfig
+{
+  /** @brief Nombre de coefficients (dimension de la ligne à retard). */
+  entier ncoefs = 15;
+
+  /** @brief Degré des polynômes en @f$\tau@f$ (typiquement 3 : cubique, ou 5 : quintique). */
+  entier degré = 5;
+
+  /** @brief %Fréquence de coupure normalisée (sinus cardinal approché). */
+  float fcut = 0.5;
+
+  /** @brief Type de fenêtre ("hn" ou "re") */
+  string fenetre = "hn";
+};
+
+/** @brief %Interpolateur de Farrow (coefficients polynomiaux en @f$\tau@f$).
+ *
+ *  Chaque coefficient du sinus cardinal fenêtré (voir itrp_sinc()) est approché, pour @f$\tau \in [0,1]@f$,
+ *  par un polynôme de degré @f$D@f$ (moindres carrés) :
+ *
+ *  @f[
+ *  h_k(\tau) \approx \sum_{d=0}^{D} c_{k,d} \cdot \left(\tau - \frac{1}{2}\right)^d
+ *  @f]
+ *
+ *  Le retard est donc continu (pas de quantification de @f$\tau@f$ sur une table de phases),
+ *  et la mémoire nécessaire est de @f$K (D+1)@f$ coefficients, au lieu de @f$K \cdot (n_{phases} + 1)@f$ pour itrp_sinc().
+ *
+ *  Les coefficients sont évalués par la méthode de Horner (coefs_into()), sans allocation :
+ *  @f$K \cdot D@f$ multiplications-additions indépendantes (vectorisées), puis le produit scalaire avec la ligne à retard.
+ *
+ *  @par Exemple
+ *  @code
+ *  soit itrp = itrp_farrow<cfloat>({15, 5, 0.45, "hn"});
+ *  float h[15];
+ *  itrp->coefs_into(0.3, h);
+ *  @endcode
+ *
+ *  @sa InterpolateurFarrowConfig, itrp_sinc(), InterpolateurRIF::coefs_into()
+ */
+template<typename T>
+  sptr<InterpolateurRIF<T>> itrp_farrow(const InterpolateurFarrowConfig &config = InterpolateurFarrowConfig());
+
+
 
 
 /** @} */
@@ -1969,15 +2540,59 @@ template<typename Tc, typename T = Tc>
   sptr<FiltreGen<T>> filtre_rif_decim(const Vecteur<Tc> &h, entier R);
 
 
-/** @brief A documenter : filtre RIF optimisé pour filtrage demi-bande
- *
+/** @brief Décimation d'un facteur 2 par un filtre RIF demi-bande.
  *
+ *  Equivalent à filtre_rif_decim() avec @f$R = 2@f$ (même convention de sortie),
+ *  mais seuls les coefficients non nuls sont utilisés : en dehors du coefficient central,
+ *  les coefficients d'un filtre demi-bande sont nuls à une distance paire du centre,
+ *  et les autres sont symétriques. Chaque sortie coûte donc @f$P + 1@f$ multiplications
+ *  (@f$P@f$ paires de coefficients repliées, et le coefficient central), au lieu de @f$K@f$,
+ *  avec les noyaux SIMD du filtrage RIF par bloc (données réelles ou complexes).
  *
+ *  @param c Coefficients du filtre (nombre impair, par exemple obtenus avec design_rif_demi_bande()).
+ *  Les coefficients supposés nuls doivent l'être aux erreurs d'arrondi près (sinon une exception est levée).
  *
- *  @sa design_rif_demi_bande() */
+ *  @sa design_rif_demi_bande(), filtre_rif_demi_bande_ups(), filtre_rif_demi_bande_cascade() */
 template<typename Tc, typename T = Tc>
   sptr<FiltreGen<T>> filtre_rif_demi_bande(const Vecteur<Tc> &c);
 
+/** @brief Interpolation d'un facteur 2 par un filtre RIF demi-bande.
+ *
+ *  Equivalent à l'insertion d'un zéro après chaque échantillon, suivie du filtre @f$2h@f$ (gain unitaire) :
+ *  @f[
+ *  y_t = \sum_k 2 h_k x'_{t-k}
+ *  @f]
+ *
+ *  Pour chaque échantillon d'entrée, l'une des deux sorties est un simple retard (coefficient central),
+ *  et l'autre n'utilise que les @f$P@f$ paires de coefficients non nuls, repliées.
+ *
+ *  @param c Coefficients du filtre demi-bande (voir filtre_rif_demi_bande()).
+ *
+ *  @sa filtre_rif_demi_bande(), filtre_rif_ups(), filtre_rif_demi_bande_cascade() */
+template<typename Tc, typename T = Tc>
+  sptr<FiltreGen<T>> filtre_rif_demi_bande_ups(const Vecteur<Tc> &c);
+
+/** @brief Cascade de @f$k@f$ filtres demi-bande (décimation ou interpolation d'un facteur @f$2^k@f$).
+ *
+ *  Les étages sont conçus ensemble (design_rif_demi_bande_cascade()) : seule la bande utile @f$[0, f_c]@f$
+ *  (relative à la fréquence d'échantillonnage la plus basse) doit être protégée,
+ *  si bien que les étages à fréquence élevée ont une bande de transition très large, et très peu de coefficients.
+ *
+ *  @param k             Nombre d'étages
+ *  @param fc            Fin de la bande utile, normalisée par rapport à la fréquence d'échantillonnage la plus basse (entre 0 et 0,5)
+ *  @param atten_db      Atténuation minimale des composantes repliées (ou des images) dans la bande utile
+ *  @param interpolation Si vrai, interpolation d'un facteur @f$2^k@f$, sinon décimation.
+ *
+ *  @par Exemple : décimation d'un facteur 8, bande utile à 40 % de la fréquence de Nyquist en sortie
+ *  @code
+ *  soit f = filtre_rif_demi_bande_cascade<cfloat>(3, 0.2);
+ *  soit y = f->step(x);
+ *  @endcode
+ *
+ *  @sa design_rif_demi_bande_cascade(), filtre_rif_demi_bande(), filtre_rif_demi_bande_ups() */
+template<typename T>
+  sptr<FiltreGen<T>> filtre_rif_demi_bande_cascade(entier k, float fc, float atten_db = 60, bouléen interpolation = non);
+
 /** @brief Filtrage RIF avec pré-insertion de zéro (implémentation polyphase)
  *
  * Cette structure permet le calcul efficace de la succession d'un sur-échantillonnage (insertion de R-1 zéros entre chaque échantillon d'entrée),
@@ -2023,12 +2638,43 @@ extern float filtre_rif_ups_délais(entier nc, entier R);
  *  L'implémentation est basée sur une cascade de décimateurs (si le ratio est inférieur à 1) ou d'interpolateurs (si le ratio est supérieur à 1) demi-bandes,
  *  suivis d'un interpolateur de ratio arbitraire.
  *
+ *  Si le ratio est rationnel, @f$L/M@f$ avec @f$L,M \leq 256@f$ (par exemple 147/160 pour passer de 48 kHz à 44,1 kHz),
+ *  et n'est pas une puissance de 2, un seul filtre polyphase est utilisé à la place (voir filtre_reechan_rationnel()).
+ *
  *  @param ratio Ratio de décimation / interpolation (rapport entre les fréquences d'échantillonnage de sortie et d'entrée).
- *  @sa rééchan(), filtre_rif_ups(), filtre_rif_decim()
+ *  @sa rééchan(), filtre_rif_ups(), filtre_rif_decim(), filtre_reechan_rationnel()
  **/
 template<typename T>
   sptr<Filtre<T,T,float>> filtre_reechan(float ratio);
 
+/** @brief Ré-échantillonnage d'un facteur rationnel @f$L/M@f$ (structure polyphase)
+ *
+ *  Equivalent à un sur-échantillonnage d'un facteur @f$L@f$ (insertion de zéros), suivi d'un filtre passe-bas
+ *  et d'une décimation d'un facteur @f$M@f$, mais seules les sorties conservées sont calculées :
+ *  chaque sortie n'utilise qu'une des @f$L@f$ phases du filtre, soit environ @f$K/L@f$ coefficients.
+ *
+ *  Le filtre prototype (fenêtre de Kaiser) a une bande passante jusqu'à @f$0{,}4 \min(f_e, f_s)@f$,
+ *  et une atténuation d'au moins @p atten_db à partir de @f$\min(f_e, f_s) / 2@f$.
+ *  Les designs sont mémorisés (par triplet @f$(L, M, \textrm{atten\_db})@f$) : créer plusieurs filtres de même ratio ne coûte rien.
+ *
+ *  Le retard introduit est de @f$(K - 1) / (2L)@f$ échantillons d'entrée.
+ *
+ *  @param L        Facteur d'interpolation
+ *  @param M        Facteur de décimation (les deux facteurs sont simplifiés par leur PGCD)
+ *  @param atten_db Atténuation minimale en bande coupée (dB)
+ *  @returns Filtre (flux de sortie au rythme @f$f_e \cdot L / M@f$)
+ *
+ *  @par Exemple : 48 kHz vers 44,1 kHz
+ *  @code
+ *  soit f = filtre_reechan_rationnel<float>(147, 160);
+ *  soit y = f->step(x);
+ *  @endcode
+ *
+ *  @sa filtre_reechan(), filtre_rif_ups(), filtre_rif_decim()
+ */
+template<typename T>
+  sptr<FiltreGen<T>> filtre_reechan_rationnel(entier L, entier M, float atten_db = 60);
+
 /** @brief Interpolation d'un ratio arbitraire (calcul au fil de l'eau)
  *
  *  @param ratio Ratio de décimation / interpolation (rapport entre les fréquences d'échantillonnage de sortie et d'entrée).
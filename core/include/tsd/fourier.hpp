@@ -29,10 +29,34 @@ namespace tsd::fourier
     virtual void step(const Veccf &x, Veccf &y, bouléen avant = oui) = 0;
 
     Veccf step(const Veccf &x, bouléen avant = oui){Veccf y(x.dim()); step(x,y,avant); retourne y;}
+
+    /** @brief Calcul de plusieurs FFT (ou IFFT) de même dimension, en un seul appel.
+     *
+     *  @param X      Signaux d'entrée (un signal par colonne si axe = 0, un signal par ligne si axe = 1)
+     *  @param Y      Signaux de sortie (mêmes dimensions que X, peut être le même tableau que X)
+     *  @param axe    Dimension suivant laquelle sont calculées les transformées (0 : colonnes, 1 : lignes)
+     *  @param avant  Si faux, FFT inverse
+     *
+     *  Pour le plan par défaut, les transformées sont entrelacées par paquets
+     *  (les boucles internes portent sur plusieurs transformées à la fois),
+     *  et les paquets sont répartis entre les threads si OpenMP est activé (LIBTSD_USE_OMP).
+     */
+    virtual void step_batch(const Tabcf &X, Tabcf &Y, entier axe = 0, bouléen avant = oui);
   };
 
   /** @cond undoc */
   extern fonction<sptr<FFTPlan>()> fftplan_defaut;
+
+  /** Si vrai (par défaut), les dimensions de la forme @f$2^a 3^b 5^c 7^d@f$
+   *  sont calculées par l'algorithme à base mixte (sinon : décomposition paire + CZT). */
+  extern bouléen tfr_radix_mixte;
+
+  /** Jeu d'instructions maximum autorisé pour les papillons radix 2
+   *  (0 : scalaire, 1 : SSE2, 2 : AVX2 / FMA, 3 : AVX-512, par défaut 3).
+   *  Le jeu effectivement utilisé dépend aussi du processeur (détection à l'exécution),
+   *  voir tfr_simd_niveau(). */
+  extern entier tfr_simd_max;
+  extern entier tfr_simd_niveau();
   /** @endcond */
 
 /** @brief Création d'un plan de calcul FFT (pour calculer efficacement plusieurs FFT).
@@ -68,6 +92,45 @@ namespace tsd::fourier
  **/
   extern sptr<FFTPlan> tfrplan_création(entier n = -1, bouléen avant = oui, bouléen normaliser = oui);
 
+/** @brief Statistiques du cache des tables de TFR.
+ *
+ *  Les facteurs de rotation (et le chirp pour les dimensions traitées par CZT)
+ *  sont calculés une seule fois par dimension, puis partagés en lecture seule entre tous les plans
+ *  (y compris entre threads). Les tampons de travail restent propres à chaque plan.
+ *
+ *  @sa tfr_cache_stats(), tfr_cache_config(), tfr_cache_vide() */
+struct TFRCacheStats
+{
+  /** Nombre de configurations pour lesquelles les tables étaient déjà dans le cache */
+  entier nb_succès    = 0;
+  /** Nombre de configurations ayant nécessité le calcul des tables */
+  entier nb_défauts   = 0;
+  /** Nombre d'entrées supprimées du cache (limite mémoire atteinte) */
+  entier nb_évictions = 0;
+  /** Nombre d'entrées actuellement dans le cache */
+  entier nb_entrées   = 0;
+  /** Occupation mémoire actuelle du cache (octets) */
+  entier octets       = 0;
+};
+
+/** @brief Statistiques d'utilisation du cache des tables de TFR. */
+extern TFRCacheStats tfr_cache_stats();
+
+/** @brief Limite l'occupation mémoire du cache des tables de TFR (par défaut 64 Mo).
+ *
+ *  Au-delà, les tables les moins récemment utilisées sont supprimées du cache
+ *  (elles restent valides pour les plans qui les utilisent encore). */
+extern void tfr_cache_config(entier octets_max);
+
+/** @brief Vide le cache des tables de TFR (et remet à zéro les statistiques). */
+extern void tfr_cache_vide();
+
+/** @cond undoc */
+// TFR / TFR réelle, avec un plan par thread (utilisé par fft(), ifft() et rfft())
+extern Veccf tfr_calcul(const Veccf &x, bouléen avant);
+extern Veccf rtfr_calcul(const Vecf &x);
+/** @endcond */
+
 /** @brief Création d'un plan de calcul FFT pour des signaux réels (pour calculer efficacement plusieurs FFT).
  *
  * Cette fonction vous permet de créer un filtre qui sera efficace pour calculer
@@ -98,6 +161,30 @@ namespace tsd::fourier
  */
 extern sptr<FiltreGen<float, cfloat>> rtfrplan_création(entier n = -1);
 
+/** @brief Création d'un plan de calcul de FFT inverse, pour des signaux réels.
+ *
+ *  Ce filtre calcule la FFT inverse (normalisée) d'un spectre à symétrie hermitienne
+ *  (typiquement, la sortie d'un plan @ref rtfrplan_création()), et produit directement un signal réel.
+ *
+ *  @param n  Dimension des vecteurs (paramètre optionnel)
+ *  @return Un %Filtre @ref cfloat vers float.
+ *
+ *  Le spectre d'entrée est le spectre complet (n points), mais seuls les @f$n/2+1@f$ premiers points sont utilisés.
+ *  Comme pour @ref rtfrplan_création(), tous les tampons de travail sont alloués à la configuration.
+ *
+ *  @par Exemple
+ *  @code
+ *  soit plan  = rtfrplan_création(N);
+ *  soit iplan = irtfrplan_création(N);
+ *  soit X = plan->step(x);
+ *  // (traitement dans le domaine fréquentiel)
+ *  soit x2 = iplan->step(X); // Signal réel
+ *  @endcode
+ *
+ *  @sa rtfrplan_création(), ifft()
+ */
+extern sptr<FiltreGen<cfloat, float>> irtfrplan_création(entier n = -1);
+
 
 /** @brief TFD d'un vecteur réel.
  *
@@ -117,8 +204,7 @@ template<typename T>
 Veccf rfft(const Vecteur<T> &x)
 {
   static_assert(!est_complexe<T>(), "RFFT : le vecteur d'entrée ne peut pas être complexe.");
-  auto plan = tsd::fourier::rtfrplan_création(x.rows());
-  return plan->step(x);
+  return tsd::fourier::rtfr_calcul(x);
 }
 
 /** @brief Ré-échantillonage zéro phase à partir de la TFD.
@@ -164,7 +250,7 @@ template<typename T>
 auto fft(const Vecteur<T> &x)
 {
   Si constexpr(est_complexe<T>())
-    retourne (tfrplan_création())->step(x);
+    retourne tfr_calcul(x, oui);
   sinon
     retourne rfft(x);
 }
@@ -200,8 +286,7 @@ extern Vecf tfd_freqs(entier n, bouléen avec_shift = non);
 template<typename T>
 auto ifft(const Vecteur<T> &X)
 {
-  soit plan = tsd::fourier::tfrplan_création();
-  return plan->step(X.as_complex(), non);
+  return tsd::fourier::tfr_calcul(X.as_complex(), non);
 }
 
 /** @brief Décalage du spectre de manière à centrer les basses fréquences au milieu.
@@ -62,6 +62,9 @@ constexpr bouléen est_complexe() { retourne est_complex_t<T>::value; }
 template<typename T, entier ndims>
   struct TabT;
 
+template<typename E>
+  struct TabExpr;
+
 
 typedef enum scalaire_enum
 {
@@ -87,6 +90,114 @@ struct NTenseurDim
   NTenseurDim operator *(const NTenseurDim &d2) const;
 };
 
+/** @endcond */
+
+/** @brief Statistiques d'allocation mémoire des tableaux (thread courant)
+ *
+ *  Permet de vérifier qu'un traitement (typiquement, les appels à <code>step()</code> d'un filtre),
+ *  une fois en régime établi, ne fait plus appel au tas global.
+ *
+ *  @sa tab_alloc_stats(), tab_alloc_stats_raz() */
+struct TabAllocStats
+{
+  /** @brief Nombre total d'allocations (données et descripteurs de tableaux) */
+  int64_t nb_allocations = 0;
+
+  /** @brief Nombre d'allocations ayant nécessité un appel au tas global (malloc) */
+  int64_t nb_allocations_tas = 0;
+
+  /** @brief Nombre d'allocations servies par un bloc recyclé (pool) */
+  int64_t nb_recyclages = 0;
+
+  /** @brief Nombre d'allocations servies par une zone temporaire (@ref ScopeScratch) */
+  int64_t nb_scratch = 0;
+
+  /** @brief Nombre total d'octets demandés */
+  int64_t octets = 0;
+};
+
+/** @brief Statistiques d'allocation des tableaux, pour le thread courant */
+extern TabAllocStats tab_alloc_stats();
+
+/** @brief Remise à zéro des statistiques d'allocation (thread courant) */
+extern void tab_alloc_stats_raz();
+
+/** @brief Alignement (en octets) des données des tableaux
+ *
+ *  Les données des tableaux alloués par la librairie commencent sur une ligne de cache,
+ *  et sont complétées jusqu'au multiple suivant de cet alignement : un noyau vectorisé
+ *  peut donc lire des vecteurs complets (alignés) jusqu'à la fin du tableau, sans traitement scalaire
+ *  des derniers éléments (les valeurs lues au-delà de la fin sont quelconques).
+ *
+ *  @sa Tab::est_aligné() */
+static const entier TAB_ALIGNEMENT = 64;
+
+/** @brief Interface d'allocateur mémoire pour les données des tableaux
+ *
+ *  Les blocs retournés doivent être alignés sur @ref TAB_ALIGNEMENT octets.
+ *
+ *  @sa tab_allocateur_def(), tab_allocateur_tas(), tab_allocateur_pools() */
+struct TabAllocateur
+{
+  virtual ~TabAllocateur(){}
+
+  /** @brief Allocation d'un bloc d'au moins <code>octets</code> octets. */
+  virtual void *alloue(std::size_t octets) = 0;
+
+  /** @brief Libération d'un bloc (<code>octets</code> : taille demandée lors de l'allocation). */
+  virtual void libère(void *ptr, std::size_t octets) = 0;
+};
+
+/** @brief Allocateur direct sur le tas global (malloc / free) */
+extern sptr<TabAllocateur> tab_allocateur_tas();
+
+/** @brief Allocateur par classes de tailles (puissances de 2), avec un cache de blocs libres par thread
+ *
+ *  C'est l'allocateur par défaut : en régime établi, les tableaux temporaires
+ *  de même taille réutilisent les mêmes blocs, sans appel au tas global. */
+extern sptr<TabAllocateur> tab_allocateur_pools();
+
+/** @brief Choix de l'allocateur utilisé pour les nouveaux tableaux
+ *
+ *  Les tableaux déjà alloués sont libérés par l'allocateur qui les a créés.
+ *  Un allocateur passé à cette fonction n'est jamais détruit. */
+extern void tab_allocateur_def(sptr<TabAllocateur> allocateur);
+
+/** @brief Allocateur actuellement utilisé pour les nouveaux tableaux */
+extern sptr<TabAllocateur> tab_allocateur();
+
+/** @brief Zone mémoire temporaire pour les tableaux créés dans un bloc de traitement
+ *
+ *  Tant qu'un objet ScopeScratch existe, les tableaux créés par le thread courant sont alloués
+ *  par simple incrément de pointeur dans une zone propre au thread. A la destruction du dernier
+ *  ScopeScratch, toute la zone est recyclée d'un coup.
+ *
+ *  Un tableau qui survit au bloc (par exemple, une sortie retournée) reste valide :
+ *  la partie de zone correspondante n'est alors simplement pas recyclée tant que le tableau existe.
+ *
+ *  @par Exemple
+ *  @code
+ *  pour(;;)
+ *  {
+ *    ScopeScratch scratch;
+ *    // Tous les temporaires ci-dessous sont recyclés à la fin de l'itération
+ *    soit y = filtre->step(x);
+ *    ...
+ *  }
+ *  @endcode
+ */
+struct ScopeScratch
+{
+  /** @brief Début d'un bloc de traitement
+   *  @param octets Taille des blocs de la zone temporaire (si elle n'est pas déjà allouée) */
+  ScopeScratch(entier octets = 1 << 20);
+  ~ScopeScratch();
+  ScopeScratch(const ScopeScratch &) = delete;
+  ScopeScratch &operator =(const ScopeScratch &) = delete;
+};
+
+/** @cond undoc */
+
 
 
   struct Tab
@@ -109,7 +220,7 @@ struct NTenseurDim
     static Tab eye(Scalaire s, entier reso, entier n);
     static Tab constant(Scalaire s, entier reso, entier n, entier m, double valeur);
     static Tab random(Scalaire s, entier reso, entier n, entier m);
-    static Tab map(Scalaire s, entier reso, entier n, entier m, void *data);
+    static Tab map(Scalaire s, entier reso, entier n, entier m, void *data, entier alignement = 0);
 
     Tab même_format() const;
 
@@ -121,6 +232,10 @@ struct NTenseurDim
 
     bouléen est_reference() const;
 
+    /** @brief Vrai si les données sont contigües, alignées sur @ref TAB_ALIGNEMENT octets,
+     *  et lisibles jusqu'au multiple suivant de @ref TAB_ALIGNEMENT octets. */
+    bouléen est_aligné() const;
+
     Tab block(entier r0, entier nr, entier c0, entier nc) const;
 
     // TODO: restrict type not complex ?
@@ -591,6 +706,17 @@ struct TabT: Tab
       retourne *this;
     }
 
+    /** @brief Evaluation d'une expression paresseuse (en une seule passe), voir @ref paresseux(). */
+    template<typename E>
+    TabT(const TabExpr<E> &e);
+
+    /** @brief Evaluation d'une expression paresseuse (en une seule passe), voir @ref paresseux().
+     *
+     *  Si le tableau a déjà les bonnes dimensions (et n'est pas partagé), le résultat
+     *  est écrit directement dans le tableau, sans allocation. */
+    template<typename E>
+    TabT &operator =(const TabExpr<E> &e);
+
     explicit TabT(entier n, entier m = 1)
     {
       soit [K, nb]= T2S<T>();
@@ -1064,16 +1190,20 @@ struct TabT: Tab
       retourne res;
     }
 
-    static TabT map(T *ptr, int n, int m = 1)
+    /** @brief Tableau faisant référence à une zone mémoire externe
+     *
+     *  @param alignement Alignement garanti (en octets) de la zone mémoire, qui doit aussi être
+     *  lisible jusqu'au multiple suivant de cet alignement (0 si inconnu, voir @ref est_aligné()). */
+    static TabT map(T *ptr, int n, int m = 1, entier alignement = 0)
     {
       soit [K, nb]= T2S<T>();
-      retourne TabT::fromTab(Tab::map(K, nb, n, m, ptr));
+      retourne TabT::fromTab(Tab::map(K, nb, n, m, ptr, alignement));
     }
 
-    static const TabT map(const T *ptr, int n, int m = 1)
+    static const TabT map(const T *ptr, int n, int m = 1, entier alignement = 0)
     {
       soit [K, nb]= T2S<T>();
-      retourne TabT::fromTab(Tab::map(K, nb, n, m, (T *) ptr));
+      retourne TabT::fromTab(Tab::map(K, nb, n, m, (T *) ptr, alignement));
     }
 
     static TabT ones(entier i, entier j = 1)
@@ -1598,6 +1728,239 @@ DOP1C2R(arg)
 DOP2(pow)
 
 
+/////////////////////////////////////////////////////////////////////////
+// Evaluation paresseuse
+/////////////////////////////////////////////////////////////////////////
+
+/** @cond undoc */
+
+/** @brief Expression paresseuse (classe de base, CRTP).
+ *
+ *  Une expression n'est qu'un arbre d'opérations : aucun calcul n'est fait
+ *  avant l'affectation à un @ref TabT, qui évalue alors tout l'arbre en une seule passe
+ *  sur les données (sans tableau intermédiaire).
+ *
+ *  Pour chaque élément, les opérations (et leurs arrondis) sont exactement celles du calcul immédiat,
+ *  et le résultat est donc identique bit à bit. */
+template<typename E>
+struct TabExpr
+{
+  const E &derivee() const {retourne static_cast<const E &>(*this);}
+  entier rows() const {retourne derivee().rows();}
+  entier cols() const {retourne derivee().cols();}
+};
+
+template<typename A, typename B>
+struct expr_promotion
+{
+  using type = std::conditional_t<est_complexe<A>() || !est_complexe<B>(), A, B>;
+};
+
+/** @brief Feuille : tableau évalué (comme pour Eigen, les données ne sont pas gardées en vie) */
+template<typename T>
+struct ExprTab: TabExpr<ExprTab<T>>
+{
+  using type = T;
+  const T *x;
+  entier nr, nc;
+
+  template<entier ndims>
+  ExprTab(const TabT<T, ndims> &t): x(t.raw_data), nr(t.rows()), nc(t.cols()){}
+
+  inline T operator[](entier i) const {retourne x[i];}
+  entier rows() const {retourne nr;}
+  entier cols() const {retourne nc;}
+};
+
+/** @brief Feuille : scalaire (dimensions -1, compatibles avec toutes les autres) */
+template<typename T>
+struct ExprScalaire: TabExpr<ExprScalaire<T>>
+{
+  using type = T;
+  T x;
+  ExprScalaire(T x): x(x){}
+  inline T operator[](entier) const {retourne x;}
+  entier rows() const {retourne -1;}
+  entier cols() const {retourne -1;}
+};
+
+template<typename Op, typename A>
+struct ExprUnaire: TabExpr<ExprUnaire<Op, A>>
+{
+  using type = decltype(Op::f(std::declval<typename A::type>()));
+  A a;
+  ExprUnaire(const A &a): a(a){}
+  inline type operator[](entier i) const {retourne Op::f(a[i]);}
+  entier rows() const {retourne a.rows();}
+  entier cols() const {retourne a.cols();}
+};
+
+template<typename Op, typename A, typename B>
+struct ExprBinaire: TabExpr<ExprBinaire<Op, A, B>>
+{
+  // Comme pour le calcul immédiat, les deux opérandes sont convertis vers le type commun
+  using type = typename expr_promotion<typename A::type, typename B::type>::type;
+  A a;
+  B b;
+  ExprBinaire(const A &a, const B &b): a(a), b(b)
+  {
+    si((a.rows() >= 0) && (b.rows() >= 0) && ((a.rows() != b.rows()) || (a.cols() != b.cols())))
+      échec("Expression paresseuse {} : dimensions incompatibles ({}x{} et {}x{})",
+            Op::nom, a.rows(), a.cols(), b.rows(), b.cols());
+  }
+  inline type operator[](entier i) const {retourne Op::f((type) a[i], (type) b[i]);}
+  entier rows() const {retourne (a.rows() >= 0) ? a.rows() : b.rows();}
+  entier cols() const {retourne (a.rows() >= 0) ? a.cols() : b.cols();}
+};
+
+namespace expr
+{
+  struct Somme      {static constexpr auto nom = "+"; template<typename T> static T f(T a, T b){retourne a + b;}};
+  struct Différence {static constexpr auto nom = "-"; template<typename T> static T f(T a, T b){retourne a - b;}};
+  struct Produit    {static constexpr auto nom = "*"; template<typename T> static T f(T a, T b){retourne a * b;}};
+  struct Quotient   {static constexpr auto nom = "/"; template<typename T> static T f(T a, T b)
+  {
+    // (la division complexe vectorisée n'est pas garantie identique à la division scalaire)
+    static_assert(!est_complexe<T>(), "Expression paresseuse : division complexe non supportée.");
+    retourne a / b;
+  }};
+  // Scalaire - tableau, scalaire / tableau (a : tableau, b : scalaire) :
+  // mêmes opérations que le calcul immédiat
+  struct DifférenceInv {static constexpr auto nom = "-"; template<typename T> static T f(T a, T b){retourne (-a) + b;}};
+  struct QuotientInv   {static constexpr auto nom = "/"; template<typename T> static T f(T a, T b)
+  {
+    static_assert(!est_complexe<T>(), "Expression paresseuse : division complexe non supportée.");
+    retourne (((T) 1) / a) * b;
+  }};
+
+  struct Opposé {template<typename T> static T f(T a){retourne -a;}};
+  struct Carré  {template<typename T> static T f(T a){retourne a * a;}};
+  struct Abs    {template<typename T> static auto f(T a){retourne std::abs(a);}};
+  struct Abs2   {template<typename T> static auto f(T a)
+  {
+    si constexpr(est_complexe<T>())
+      retourne a.real() * a.real() + a.imag() * a.imag();
+    sinon
+      retourne a * a;
+  }};
+  struct Conj   {template<typename T> static T f(T a)
+  {
+    si constexpr(est_complexe<T>())
+      retourne std::conj(a);
+    sinon
+      retourne a;
+  }};
+  struct Réel   {template<typename T> static auto f(T a){retourne std::real(a);}};
+  struct Imag   {template<typename T> static auto f(T a){retourne std::imag(a);}};
+
+  template<typename X>
+  auto feuille(const TabExpr<X> &x){retourne x.derivee();}
+  template<typename T, entier ndims>
+  auto feuille(const TabT<T, ndims> &x){retourne ExprTab<T>(x);}
+  template<typename T>
+  auto feuille(const T &x) requires(std::is_arithmetic_v<T> || est_complexe<T>()) {retourne ExprScalaire<T>(x);}
+
+  template<typename X>
+  concept est_expr = std::is_base_of_v<TabExpr<X>, X>;
+
+  template<typename X>
+  concept opérande = est_expr<X> || std::is_arithmetic_v<X> || est_complexe<X>() || requires(const X &x){ExprTab(x);};
+}
+
+/** @endcond */
+
+/** @brief Début d'une expression paresseuse.
+ *
+ *  Les opérations terme à terme (+, -, *, /, abs, abs2, square, conj, real, imag)
+ *  sur le résultat ne sont pas calculées immédiatement, mais fusionnées, et évaluées en
+ *  une seule passe au moment de l'affectation à un tableau (pas de tableau intermédiaire).
+ *  Le résultat est identique bit à bit à celui du calcul immédiat.
+ *
+ *  Les fonctions dont la version vectorisée (Eigen) est approchée (sqrt, exp, log, sin, ...)
+ *  ne sont pas disponibles dans une expression paresseuse.
+ *
+ *  @warning L'expression référence les tableaux utilisés, elle doit donc être affectée
+ *  (et non stockée avec <code>soit</code>) si ces tableaux sont temporaires.
+ *
+ *  @par Exemple
+ *  @code
+ *  // Un seul parcours des données, une seule allocation (ou aucune si y a déjà la bonne dimension)
+ *  y = ratio * abs2(paresseux(corr)) / (paresseux(en) + 1e-20f);
+ *  @endcode
+ */
+template<typename T, entier ndims>
+ExprTab<T> paresseux(const TabT<T, ndims> &x)
+{
+  retourne ExprTab<T>(x);
+}
+
+/** @cond undoc */
+
+#define TSD_EXPR_OP2(OP, OPN, OPNI)\
+template<typename A, typename B>\
+auto operator OP(const A &a, const B &b)\
+requires((expr::est_expr<A> || expr::est_expr<B>) && expr::opérande<A> && expr::opérande<B>)\
+{\
+  soit fa = expr::feuille(a);\
+  soit fb = expr::feuille(b);\
+  si constexpr((std::is_arithmetic_v<A> || est_complexe<A>()) && !expr::est_expr<A>)\
+    retourne ExprBinaire<expr::OPNI, decltype(fb), decltype(fa)>(fb, fa);\
+  sinon\
+    retourne ExprBinaire<expr::OPN, decltype(fa), decltype(fb)>(fa, fb);\
+}
+
+TSD_EXPR_OP2(+, Somme,      Somme)
+TSD_EXPR_OP2(-, Différence, DifférenceInv)
+TSD_EXPR_OP2(*, Produit,    Produit)
+TSD_EXPR_OP2(/, Quotient,   QuotientInv)
+
+#define TSD_EXPR_OP1(FN, OPN)\
+template<typename A>\
+auto FN(const TabExpr<A> &a)\
+{\
+  retourne ExprUnaire<expr::OPN, A>(a.derivee());\
+}
+
+TSD_EXPR_OP1(operator -, Opposé)
+TSD_EXPR_OP1(square,     Carré)
+TSD_EXPR_OP1(abs,        Abs)
+TSD_EXPR_OP1(abs2,       Abs2)
+TSD_EXPR_OP1(conj,       Conj)
+TSD_EXPR_OP1(real,       Réel)
+TSD_EXPR_OP1(imag,       Imag)
+
+template<typename T, entier ndims>
+template<typename E>
+TabT<T, ndims>::TabT(const TabExpr<E> &e): TabT(e.rows(), e.cols())
+{
+  soit &d = e.derivee();
+  soit n = nelems();
+  pour(auto i = 0; i < n; i++)
+    raw_data[i] = (T) d[i];
+}
+
+template<typename T, entier ndims>
+template<typename E>
+TabT<T, ndims> &TabT<T, ndims>::operator =(const TabExpr<E> &e)
+{
+  soit nr = e.rows(), nc = e.cols();
+  // Ecriture directe possible : mêmes dimensions, et (si tableau propre) non partagé
+  // (chaque élément ne dépend que des éléments de même index, donc l'aliasing ne pose pas de problème)
+  si(impl && (rows() == nr) && (cols() == nc) && (est_reference() || (impl.use_count() == 1)))
+  {
+    soit &d = e.derivee();
+    soit n = nelems();
+    pour(auto i = 0; i < n; i++)
+      raw_data[i] = (T) d[i];
+  }
+  sinon
+    *this = TabT<T, ndims>(e);
+  retourne *this;
+}
+
+/** @endcond */
+
+
 
 template<typename T, entier ndims>
   TabT<T, ndims> Tab::as() const
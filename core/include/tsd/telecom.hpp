@@ -646,6 +646,111 @@ struct DSSSConfig
 extern sptr<Filtre<cfloat,cfloat,DSSSConfig>> dsss_modulation(const DSSSConfig &config);
 
 
+/** @brief Configuration d'un banc de filtres polyphase (canaliseur / synthétiseur) */
+struct CanaliseurPFBConfig
+{
+  /** @brief Nombre de canaux (M) */
+  entier nb_canaux = 16;
+
+  /** @brief Sur-échantillonnage des canaux : 1 (échantillonnage critique, décimation d'un facteur M),
+   *  ou 2 (décimation d'un facteur M/2, M pair) */
+  entier sur_échantillonnage = 1;
+
+  /** @brief Filtre prototype (passe-bas, gain unitaire en DC).
+   *  Si vide, un filtre de Kaiser est calculé (coupure à -6 dB en @f$1/2M@f$,
+   *  bande de transition de @f$0{,}2/M@f$ (échantillonnage critique) ou @f$0{,}5/M@f$ (sur-échantillonnage)). */
+  Vecf h;
+
+  /** @brief Atténuation du prototype calculé automatiquement (dB) */
+  float atten_db = 60;
+};
+
+/** @brief Canaliseur : séparation d'un signal en M canaux, au fil de l'eau */
+struct CanaliseurPFB
+{
+  virtual ~CanaliseurPFB(){}
+
+  /** @brief Traitement d'un bloc de données
+   *  @param x  Signal d'entrée (nombre d'échantillons quelconque)
+   *  @param Y  Signaux des canaux, en bande de base (une ligne par instant de sortie, une colonne par canal)
+   */
+  virtual void step(const Veccf &x, Tabcf &Y) = 0;
+
+  /** @brief Traitement d'un bloc de données */
+  Tabcf step(const Veccf &x)
+  {
+    Tabcf Y;
+    step(x, Y);
+    retourne Y;
+  }
+};
+
+/** @brief Synthétiseur : multiplexage fréquentiel de M canaux, au fil de l'eau */
+struct SynthétiseurPFB
+{
+  virtual ~SynthétiseurPFB(){}
+
+  /** @brief Traitement d'un bloc de données
+   *  @param X  Signaux des canaux (une ligne par instant, une colonne par canal)
+   *  @param y  Signal de sortie (R échantillons par ligne de X)
+   */
+  virtual void step(const Tabcf &X, Veccf &y) = 0;
+
+  /** @brief Traitement d'un bloc de données */
+  Veccf step(const Tabcf &X)
+  {
+    Veccf y;
+    step(X, y);
+    retourne y;
+  }
+};
+
+/** @brief Canaliseur polyphase (banc de filtres d'analyse, méthode de Harris)
+ *
+ *  Le canal k (@f$0\leq k < M@f$) est le signal d'entrée transposé de la fréquence @f$k/M@f$ vers 0,
+ *  filtré par le prototype h, puis décimé d'un facteur R (@f$R = M@f$, ou @f$M/2@f$ si sur-échantillonné) :
+ *  @f[
+ *  y_k(m) = \sum_n h_n x(t_m - n) e^{-2\pi\mathbf{i} k (t_m - n) / M},\quad t_m = mR + R - 1
+ *  @f]
+ *
+ *  Pour chaque instant de sortie, les M sommes polyphase
+ *  (coefficients sous forme polyphase, voir forme_polyphase()) sont formées sur une fenêtre contiguë
+ *  du signal d'entrée, puis une TFR de dimension M donne les M canaux
+ *  (la rotation circulaire de l'entrée de la TFR compense la phase @f$t_m \bmod M@f$).
+ *  Les TFR d'un même bloc sont calculées en un seul appel (FFTPlan::step_batch()).
+ *
+ *  Les tampons sont conservés d'un appel à l'autre : pas d'allocation tant que la dimension des blocs ne change pas.
+ *
+ *  @param config Configuration (nombre de canaux, sur-échantillonnage, prototype)
+ *  @returns Canaliseur (signal @f$\to@f$ tableau instants x canaux)
+ *
+ *  @sa synthétiseur_pfb()
+ */
+extern sptr<CanaliseurPFB> canaliseur_pfb(const CanaliseurPFBConfig &config);
+
+/** @brief Synthétiseur polyphase (banc de filtres de synthèse)
+ *
+ *  Opération inverse de canaliseur_pfb() : chaque canal est sur-échantillonné d'un facteur R,
+ *  filtré par le prototype (gain R), et transposé à la fréquence @f$k/M@f$ :
+ *  @f[
+ *  y(t) = \sum_k e^{2\pi\mathbf{i} k (t - D) / M} \sum_m x_k(m) \cdot R h_{t - mR},\quad D = K - R
+ *  @f]
+ *
+ *  Avec la même configuration, et un prototype à phase linéaire de K coefficients, le canaliseur suivi du synthétiseur
+ *  reconstitue le signal d'entrée retardé de @f$D@f$ échantillons (aux erreurs de repliement près aux bords des canaux,
+ *  négligeables si les canaux sont sur-échantillonnés).
+ *
+ *  Pour chaque instant d'entrée, une TFR inverse de dimension M (calculées en un seul appel pour tout le bloc),
+ *  puis K multiplications-accumulations (addition-recouvrement).
+ *
+ *  @param config Configuration (nombre de canaux, sur-échantillonnage, prototype)
+ *  @returns Synthétiseur (tableau instants x canaux @f$\to@f$ signal)
+ *
+ *  @sa canaliseur_pfb()
+ */
+extern sptr<SynthétiseurPFB> synthétiseur_pfb(const CanaliseurPFBConfig &config);
+
+
 /** @brief Configuration d'une transposition en bande de base */
 struct TranspoBBConfig
 {
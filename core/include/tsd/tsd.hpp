@@ -6,6 +6,7 @@
 #include <numbers>
 #include <random>
 #include <algorithm>
+#include <span>
 
 #include "tsd/tableau.hpp"
 
@@ -646,7 +647,12 @@ using std::norm;
       retourne y;
     }
 
-    Ts step(Te x)
+    /** @brief Traitement d'un seul échantillon
+     *
+     *  Les filtres de base (RIF, RII, SOIS, exponentiel, moyenne glissante, ligne à retard, DC)
+     *  implémentent directement cette méthode, sans allocation.
+     *  Par défaut, passe par un vecteur de dimension 1. */
+    virtual Ts step_éch(Te x)
     {
       Vecteur<Te> vx(1);
       Vecteur<Ts> vy(1);
@@ -654,6 +660,54 @@ using std::norm;
       step(vx, vy);
       retourne vy(0);
     }
+
+    /** @brief Traitement d'un seul échantillon (voir @ref step_éch()) */
+    Ts step(Te x)
+    {
+      retourne step_éch(x);
+    }
+
+    /** @brief Nombre maximal d'échantillons produits pour <code>n</code> échantillons d'entrée
+     *
+     *  Permet à l'appelant de pré-allouer la sortie de @ref step(std::span<const Te>, std::span<Ts>).
+     *  Par défaut, <code>n</code> (pas de changement de rythme). */
+    virtual entier dim_sortie_max(entier n) const
+    {
+      retourne n;
+    }
+
+    /** @brief Traitement d'un bloc de données, directement dans des zones mémoire de l'appelant
+     *
+     *  @param x  Signal d'entrée
+     *  @param y  Signal de sortie, d'au moins @ref dim_sortie_max() éléments (peut être la même zone que x)
+     *  @returns  Nombre d'échantillons écrits dans y
+     *
+     *  Par défaut, les zones mémoire sont vues comme des tableaux (@ref TabT::map()), et, pour
+     *  un filtre sans changement de rythme, la sortie est écrite directement dans y (sans copie).
+     */
+    virtual std::size_t step(std::span<const Te> x, std::span<Ts> y)
+    {
+      entier n = x.size();
+      soit vx  = Vecteur<Te>::map(x.data(), n);
+      si((dim_sortie_max(n) == n) && ((entier) y.size() >= n))
+      {
+        soit vy = Vecteur<Ts>::map(y.data(), n);
+        step(vx, vy);
+        // Le filtre a pu ré-allouer la sortie
+        si(vy.data() == y.data())
+          retourne vy.rows();
+        assertion_msg(vy.rows() <= (entier) y.size(),
+            "FiltreGen::step(span) : sortie trop petite ({} éléments, {} nécessaires).", y.size(), vy.rows());
+        std::copy(vy.data(), vy.data() + vy.rows(), y.data());
+        retourne vy.rows();
+      }
+      Vecteur<Ts> vy;
+      step(vx, vy);
+      assertion_msg(vy.rows() <= (entier) y.size(),
+          "FiltreGen::step(span) : sortie trop petite ({} éléments, {} nécessaires).", y.size(), vy.rows());
+      std::copy(vy.data(), vy.data() + vy.rows(), y.data());
+      retourne vy.rows();
+    }
   };
 
   /** @brief Structure abstraite pour un filtre de données configurable
@@ -0,0 +1,661 @@
+#include "tsd/tsd.hpp"
+#include "tsd/filtrage.hpp"
+#include "tsd/fourier.hpp"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define TSD_FIXE_SIMD 1
+# include <immintrin.h>
+#else
+# define TSD_FIXE_SIMD 0
+#endif
+
+using namespace std;
+using namespace tsd::fourier;
+
+namespace tsd::filtrage
+{
+
+/////////////////////////////////////////////////////////////////////////
+// Formats virgule fixe
+/////////////////////////////////////////////////////////////////////////
+
+// Q15 : échantillons 16 bits, accumulateur 32 bits ; Q31 : échantillons 32 bits, accumulateur 64 bits
+template<typename T> struct FixeTraits;
+
+template<> struct FixeTraits<int16_t>
+{
+  using Tacc = int32_t;
+  static constexpr entier nb_bits = 16, nb_bits_acc = 32;
+};
+
+template<> struct FixeTraits<int32_t>
+{
+  using Tacc = int64_t;
+  static constexpr entier nb_bits = 32, nb_bits_acc = 64;
+};
+
+template<typename T>
+static inline T fixe_sature(int64_t v, FiltreFixeStats &stats)
+{
+  constexpr int64_t vmax = (int64_t) std::numeric_limits<T>::max(),
+                    vmin = (int64_t) std::numeric_limits<T>::min();
+  si(v > vmax)
+  {
+    stats.nb_saturations++;
+    retourne (T) vmax;
+  }
+  si(v < vmin)
+  {
+    stats.nb_saturations++;
+    retourne (T) vmin;
+  }
+  retourne (T) v;
+}
+
+// Arrondi au plus proche (demi-entiers vers +infini) et décalage de f bits
+static inline int64_t fixe_arrondi(int64_t acc, entier f)
+{
+  si(f <= 0)
+    retourne acc;
+  retourne (acc + (((int64_t) 1) << (f - 1))) >> f;
+}
+
+template<typename T>
+static T fixe_quantifie(double v, entier f, FiltreFixeStats &stats)
+{
+  retourne fixe_sature<T>((int64_t) std::llround(std::ldexp(v, f)), stats);
+}
+
+template<typename T>
+void vers_fixe(std::span<const float> x, std::span<T> y, entier nb_bits_frac)
+{
+  assertion_msg(y.size() >= x.size(),
+      "vers_fixe : sortie trop petite ({} éléments, {} nécessaires).", y.size(), x.size());
+  si(nb_bits_frac < 0)
+    nb_bits_frac = FixeTraits<T>::nb_bits - 1;
+  FiltreFixeStats stats;
+  pour(auto i = 0u; i < x.size(); i++)
+    y[i] = fixe_quantifie<T>(x[i], nb_bits_frac, stats);
+}
+
+template<typename T>
+void depuis_fixe(std::span<const T> x, std::span<float> y, entier nb_bits_frac)
+{
+  assertion_msg(y.size() >= x.size(),
+      "depuis_fixe : sortie trop petite ({} éléments, {} nécessaires).", y.size(), x.size());
+  si(nb_bits_frac < 0)
+    nb_bits_frac = FixeTraits<T>::nb_bits - 1;
+  soit g = std::ldexp(1.0, -nb_bits_frac);
+  pour(auto i = 0u; i < x.size(); i++)
+    y[i] = (float) (x[i] * g);
+}
+
+/** @brief Choix du nombre de bits fractionnaires des coefficients
+ *
+ *  Le plus grand f <= fmax tel que les coefficients quantifiés tiennent sur B bits,
+ *  et que la somme de leurs valeurs absolues soit inférieure à @f$2^{A-B}@f$ :
+ *  l'accumulateur (A bits) ne peut alors pas déborder, quelle que soit l'entrée (B bits).
+ *  Si f est imposé (f >= 0), vérifie seulement ces deux conditions. */
+template<typename T>
+static entier fixe_bits_coefs(const Vecd &c, entier f, entier fmax, entier nb_bits_acc, cstring nom)
+{
+  constexpr entier B = FixeTraits<T>::nb_bits;
+  soit valide = [&](entier f)
+  {
+    double somme = 0;
+    pour(auto k = 0; k < c.rows(); k++)
+    {
+      soit q = std::abs((double) std::llround(std::ldexp(c(k), f)));
+      si(q > std::ldexp(1.0, B - 1) - 1)
+        retourne non;
+      somme += q;
+    }
+    retourne somme < std::ldexp(1.0, nb_bits_acc - B);
+  };
+  si(f >= 0)
+  {
+    si(!valide(f))
+      échec("{} : format des coefficients (Q{}) invalide (débordement possible des coefficients "
+            "ou de l'accumulateur).", nom, f);
+    retourne f;
+  }
+  pour(f = fmax; f >= 0; f--)
+    si(valide(f))
+      retourne f;
+  échec("{} : coefficients trop grands pour le format virgule fixe.", nom);
+  retourne 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+// Noyaux RIF virgule fixe
+/////////////////////////////////////////////////////////////////////////
+
+/** @brief acc[i] += somme_{j < J} cp[j] . p[i + 2j], i < m (Q15)
+ *
+ *  p[n] = (a[n], a[n+1]) : paires d'échantillons 16 bits, cp[j] = (c[2j], c[2j+1]) : paires de coefficients.
+ *  Une instruction pmaddwd calcule ainsi, pour chaque sortie, deux produits et leur somme (32 bits). */
+static void rif_q15_scalaire(const int32_t *cp, entier J, const int32_t *p, int32_t *acc, entier m)
+{
+  pour(auto i = 0; i < m; i++)
+  {
+    int32_t s = 0;
+    pour(auto j = 0; j < J; j++)
+    {
+      soit u = p[i + 2 * j], c = cp[j];
+      s += (int32_t) (int16_t) u * (int32_t) (int16_t) c
+         + (int32_t) (int16_t) (u >> 16) * (int32_t) (int16_t) (c >> 16);
+    }
+    acc[i] += s;
+  }
+}
+
+#if TSD_FIXE_SIMD
+__attribute__((target("avx2")))
+static void rif_q15_avx2(const int32_t *cp, entier J, const int32_t *p, int32_t *acc, entier m)
+{
+  entier i0 = 0;
+  pour(; i0 + 32 <= m; i0 += 32)
+  {
+    __m256i a0 = _mm256_loadu_si256((const __m256i *) (acc + i0)),
+            a1 = _mm256_loadu_si256((const __m256i *) (acc + i0 + 8)),
+            a2 = _mm256_loadu_si256((const __m256i *) (acc + i0 + 16)),
+            a3 = _mm256_loadu_si256((const __m256i *) (acc + i0 + 24));
+    soit pp = p + i0;
+    pour(auto j = 0; j < J; j++, pp += 2)
+    {
+      soit c = _mm256_set1_epi32(cp[j]);
+      a0 = _mm256_add_epi32(a0, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) pp),        c));
+      a1 = _mm256_add_epi32(a1, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (pp + 8)),  c));
+      a2 = _mm256_add_epi32(a2, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (pp + 16)), c));
+      a3 = _mm256_add_epi32(a3, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (pp + 24)), c));
+    }
+    _mm256_storeu_si256((__m256i *) (acc + i0),      a0);
+    _mm256_storeu_si256((__m256i *) (acc + i0 + 8),  a1);
+    _mm256_storeu_si256((__m256i *) (acc + i0 + 16), a2);
+    _mm256_storeu_si256((__m256i *) (acc + i0 + 24), a3);
+  }
+  pour(; i0 + 8 <= m; i0 += 8)
+  {
+    __m256i a0 = _mm256_loadu_si256((const __m256i *) (acc + i0));
+    pour(auto j = 0; j < J; j++)
+      a0 = _mm256_add_epi32(a0, _mm256_madd_epi16(
+              _mm256_loadu_si256((const __m256i *) (p + i0 + 2 * j)), _mm256_set1_epi32(cp[j])));
+    _mm256_storeu_si256((__m256i *) (acc + i0), a0);
+  }
+  rif_q15_scalaire(cp, J, p + i0, acc + i0, m - i0);
+}
+
+__attribute__((target("avx512f,avx512bw,avx2")))
+static void rif_q15_avx512(const int32_t *cp, entier J, const int32_t *p, int32_t *acc, entier m)
+{
+  entier i0 = 0;
+  pour(; i0 + 64 <= m; i0 += 64)
+  {
+    __m512i a0 = _mm512_loadu_si512(acc + i0),
+            a1 = _mm512_loadu_si512(acc + i0 + 16),
+            a2 = _mm512_loadu_si512(acc + i0 + 32),
+            a3 = _mm512_loadu_si512(acc + i0 + 48);
+    soit pp = p + i0;
+    pour(auto j = 0; j < J; j++, pp += 2)
+    {
+      soit c = _mm512_set1_epi32(cp[j]);
+      a0 = _mm512_add_epi32(a0, _mm512_madd_epi16(_mm512_loadu_si512(pp),      c));
+      a1 = _mm512_add_epi32(a1, _mm512_madd_epi16(_mm512_loadu_si512(pp + 16), c));
+      a2 = _mm512_add_epi32(a2, _mm512_madd_epi16(_mm512_loadu_si512(pp + 32), c));
+      a3 = _mm512_add_epi32(a3, _mm512_madd_epi16(_mm512_loadu_si512(pp + 48), c));
+    }
+    _mm512_storeu_si512(acc + i0,      a0);
+    _mm512_storeu_si512(acc + i0 + 16, a1);
+    _mm512_storeu_si512(acc + i0 + 32, a2);
+    _mm512_storeu_si512(acc + i0 + 48, a3);
+  }
+  rif_q15_avx2(cp, J, p + i0, acc + i0, m - i0);
+}
+#endif
+
+/** @brief acc[i] += somme_{k < K} c[k] . a[i + k], i < m (Q31)
+ *
+ *  Échantillons étendus sur 64 bits, produits 32 x 32 -> 64 bits (pmuldq). */
+static void rif_q31_scalaire(const int64_t *c, entier K, const int64_t *a, int64_t *acc, entier m)
+{
+  pour(auto i = 0; i < m; i++)
+  {
+    int64_t s = 0;
+    pour(auto k = 0; k < K; k++)
+      s += c[k] * a[i + k];
+    acc[i] += s;
+  }
+}
+
+#if TSD_FIXE_SIMD
+__attribute__((target("avx2")))
+static void rif_q31_avx2(const int64_t *c, entier K, const int64_t *a, int64_t *acc, entier m)
+{
+  entier i0 = 0;
+  pour(; i0 + 16 <= m; i0 += 16)
+  {
+    __m256i a0 = _mm256_loadu_si256((const __m256i *) (acc + i0)),
+            a1 = _mm256_loadu_si256((const __m256i *) (acc + i0 + 4)),
+            a2 = _mm256_loadu_si256((const __m256i *) (acc + i0 + 8)),
+            a3 = _mm256_loadu_si256((const __m256i *) (acc + i0 + 12));
+    soit ap = a + i0;
+    pour(auto k = 0; k < K; k++, ap++)
+    {
+      soit ck = _mm256_set1_epi64x(c[k]);
+      a0 = _mm256_add_epi64(a0, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *) ap),        ck));
+      a1 = _mm256_add_epi64(a1, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *) (ap + 4)),  ck));
+      a2 = _mm256_add_epi64(a2, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *) (ap + 8)),  ck));
+      a3 = _mm256_add_epi64(a3, _mm256_mul_epi32(_mm256_loadu_si256((const __m256i *) (ap + 12)), ck));
+    }
+    _mm256_storeu_si256((__m256i *) (acc + i0),      a0);
+    _mm256_storeu_si256((__m256i *) (acc + i0 + 4),  a1);
+    _mm256_storeu_si256((__m256i *) (acc + i0 + 8),  a2);
+    _mm256_storeu_si256((__m256i *) (acc + i0 + 12), a3);
+  }
+  rif_q31_scalaire(c, K, a + i0, acc + i0, m - i0);
+}
+
+__attribute__((target("avx512f,avx2")))
+static void rif_q31_avx512(const int64_t *c, entier K, const int64_t *a, int64_t *acc, entier m)
+{
+  entier i0 = 0;
+  pour(; i0 + 32 <= m; i0 += 32)
+  {
+    __m512i a0 = _mm512_loadu_si512(acc + i0),
+            a1 = _mm512_loadu_si512(acc + i0 + 8),
+            a2 = _mm512_loadu_si512(acc + i0 + 16),
+            a3 = _mm512_loadu_si512(acc + i0 + 24);
+    soit ap = a + i0;
+    pour(auto k = 0; k < K; k++, ap++)
+    {
+      soit ck = _mm512_set1_epi64(c[k]);
+      a0 = _mm512_add_epi64(a0, _mm512_mul_epi32(_mm512_loadu_si512(ap),      ck));
+      a1 = _mm512_add_epi64(a1, _mm512_mul_epi32(_mm512_loadu_si512(ap + 8),  ck));
+      a2 = _mm512_add_epi64(a2, _mm512_mul_epi32(_mm512_loadu_si512(ap + 16), ck));
+      a3 = _mm512_add_epi64(a3, _mm512_mul_epi32(_mm512_loadu_si512(ap + 24), ck));
+    }
+    _mm512_storeu_si512(acc + i0,      a0);
+    _mm512_storeu_si512(acc + i0 + 8,  a1);
+    _mm512_storeu_si512(acc + i0 + 16, a2);
+    _mm512_storeu_si512(acc + i0 + 24, a3);
+  }
+  rif_q31_avx2(c, K, a + i0, acc + i0, m - i0);
+}
+
+// Niveau SIMD pour les noyaux entiers (AVX512BW nécessaire pour pmaddwd sur 512 bits)
+static entier fixe_simd_niveau()
+{
+  static const bouléen avx512bw = []
+  {
+    __builtin_cpu_init();
+    retourne (bouléen) __builtin_cpu_supports("avx512bw");
+  }();
+  soit niveau = tfr_simd_niveau();
+  si((niveau == 3) && !avx512bw)
+    niveau = 2;
+  retourne niveau;
+}
+#endif
+
+/** @brief Arrondi, saturation et statistiques : y[j] = sat((acc[j] + 2^(f-1)) >> f), j < m
+ *
+ *  (boucle sans branchement, vectorisée par le compilateur) */
+template<typename T, typename Tacc>
+static inline void fixe_sortie_noyau(const Tacc *acc, T *y, entier m, entier f, FiltreFixeStats &stats)
+{
+  const Tacc demi = (f > 0) ? ((Tacc) 1) << (f - 1) : 0,
+             vmax = std::numeric_limits<T>::max(),
+             vmin = std::numeric_limits<T>::min();
+  Tacc max_acc = 0, max_sortie = 0, nb_sat = 0;
+  pour(auto j = 0; j < m; j++)
+  {
+    soit a = acc[j];
+    max_acc = max(max_acc, (a < 0) ? -a : a);
+    soit v = (a + demi) >> f;
+    soit c = min(max(v, vmin), vmax);
+    nb_sat += (c != v);
+    max_sortie = max(max_sortie, (c < 0) ? -c : c);
+    y[j] = (T) c;
+  }
+  stats.max_abs_acc     = max(stats.max_abs_acc,    (int64_t) max_acc);
+  stats.max_abs_sortie  = max(stats.max_abs_sortie, (int64_t) max_sortie);
+  stats.nb_saturations += nb_sat;
+  stats.nb_échantillons += m;
+}
+
+#if TSD_FIXE_SIMD
+template<typename T, typename Tacc>
+__attribute__((target("avx2"), flatten))
+static void fixe_sortie_avx2(const Tacc *acc, T *y, entier m, entier f, FiltreFixeStats &stats)
+{
+  fixe_sortie_noyau(acc, y, m, f, stats);
+}
+
+template<typename T, typename Tacc>
+__attribute__((target("avx512f,avx512bw,avx512vl,avx2"), flatten))
+static void fixe_sortie_avx512(const Tacc *acc, T *y, entier m, entier f, FiltreFixeStats &stats)
+{
+  fixe_sortie_noyau(acc, y, m, f, stats);
+}
+#endif
+
+template<typename T, typename Tacc>
+static void fixe_sortie(const Tacc *acc, T *y, entier m, entier f, FiltreFixeStats &stats)
+{
+# if TSD_FIXE_SIMD
+  soit niveau = fixe_simd_niveau();
+  si(niveau == 3)
+    retourne fixe_sortie_avx512(acc, y, m, f, stats);
+  si(niveau == 2)
+    retourne fixe_sortie_avx2(acc, y, m, f, stats);
+# endif
+  fixe_sortie_noyau(acc, y, m, f, stats);
+}
+
+/////////////////////////////////////////////////////////////////////////
+// Filtre RIF (avec décimation éventuelle) en virgule fixe
+/////////////////////////////////////////////////////////////////////////
+
+/** @brief Filtre RIF virgule fixe, avec décimation d'un facteur R (R = 1 : pas de décimation)
+ *
+ *  Même convention que la structure polyphase de filtre_rif_decim() :
+ *  avec ext = [K-1 échantillons précédents, x], y_j = somme_i c_i ext[t0 + R.j + i],
+ *  calculé branche par branche (coefficients c_{R.q + r}, échantillons x_r[p] = ext[t0 + r + R.p]).
+ *  Les échantillons de chaque branche sont préparés pour le noyau entier
+ *  (paires 16 bits en Q15, extension sur 64 bits en Q31). */
+template<typename T>
+struct FiltreRIFFixe: FiltreFixe<T>
+{
+  using Tacc = typename FixeTraits<T>::Tacc;
+  static constexpr bouléen q15 = std::is_same_v<T, int16_t>;
+  // Échantillons préparés : paires (Q15) ou extension 64 bits (Q31)
+  using Tp = std::conditional_t<q15, int32_t, int64_t>;
+
+  struct Branche
+  {
+    entier Q = 0;
+    // Q15 : paires de coefficients, Q31 : coefficients étendus sur 64 bits
+    vector<Tp> c;
+  };
+
+  entier K = 0, R = 1, cnt = 0;
+  vector<Branche> branches;
+  vector<T>       ext;
+  vector<Tp>      xp;
+  vector<Tacc>    acc;
+
+  FiltreRIFFixe(const Vecd &c, entier R, entier nb_bits_frac, cstring nom)
+  {
+    K = c.rows();
+    this->R = R;
+    si(K == 0)
+      échec("{} : filtre vide.", nom);
+    si(R <= 0)
+      échec("{} : facteur de décimation invalide ({}).", nom, R);
+
+    constexpr entier B = FixeTraits<T>::nb_bits;
+    soit f = fixe_bits_coefs<T>(c, nb_bits_frac, B - 1, FixeTraits<T>::nb_bits_acc, nom);
+    this->nb_bits_frac = f;
+
+    FiltreFixeStats st;
+    vector<T> cq(K);
+    pour(auto k = 0; k < K; k++)
+      cq[k] = fixe_quantifie<T>(c(k), f, st);
+
+    branches.resize(R);
+    pour(auto r = 0; r < R; r++)
+    {
+      soit &b = branches[r];
+      b.Q = (r < K) ? (K - 1 - r) / R + 1 : 0;
+      si constexpr(q15)
+      {
+        b.c.assign((b.Q + 1) / 2, 0);
+        pour(auto q = 0; q < b.Q; q++)
+        {
+          soit v = (uint16_t) cq[R * q + r];
+          b.c[q / 2] |= (int32_t) (((uint32_t) v) << (16 * (q & 1)));
+        }
+      }
+      sinon
+      {
+        b.c.resize(b.Q);
+        pour(auto q = 0; q < b.Q; q++)
+          b.c[q] = cq[R * q + r];
+      }
+    }
+    ext.assign(K - 1, 0);
+  }
+
+  entier dim_sortie_max(entier n) const override
+  {
+    retourne (n + cnt) / R;
+  }
+
+  // acc[j] += somme_q c_q x_r[j + q], j < m
+  void branche(const Branche &b, const T *src, entier m)
+  {
+    si(b.Q == 0)
+      retourne;
+    // Échantillons de la branche (plus un zéro, pour la dernière paire si Q est impair)
+    soit L = m + b.Q - 1;
+    si((entier) xp.size() < L + 1)
+      xp.resize(L + 1);
+    si constexpr(q15)
+    {
+      soit paire = [](T u, T v)
+      {
+        retourne (int32_t) (((uint32_t) (uint16_t) u) | (((uint32_t) (uint16_t) v) << 16));
+      };
+      si(R == 1)
+      {
+        pour(auto p = 0; p + 1 < L; p++)
+          xp[p] = paire(src[p], src[p + 1]);
+      }
+      sinon
+      {
+        pour(auto p = 0; p + 1 < L; p++)
+          xp[p] = paire(src[R * p], src[R * (p + 1)]);
+      }
+      xp[L - 1] = paire(src[R * (L - 1)], 0);
+      soit J = (b.Q + 1) / 2;
+#     if TSD_FIXE_SIMD
+      soit niveau = fixe_simd_niveau();
+      si(niveau == 3)
+        retourne rif_q15_avx512(b.c.data(), J, xp.data(), acc.data(), m);
+      si(niveau == 2)
+        retourne rif_q15_avx2(b.c.data(), J, xp.data(), acc.data(), m);
+#     endif
+      rif_q15_scalaire(b.c.data(), J, xp.data(), acc.data(), m);
+    }
+    sinon
+    {
+      pour(auto p = 0; p < L; p++)
+        xp[p] = src[R * p];
+#     if TSD_FIXE_SIMD
+      soit niveau = fixe_simd_niveau();
+      si(niveau == 3)
+        retourne rif_q31_avx512(b.c.data(), b.Q, xp.data(), acc.data(), m);
+      si(niveau == 2)
+        retourne rif_q31_avx2(b.c.data(), b.Q, xp.data(), acc.data(), m);
+#     endif
+      rif_q31_scalaire(b.c.data(), b.Q, xp.data(), acc.data(), m);
+    }
+  }
+
+  size_t step(std::span<const T> x, std::span<T> y) override
+  {
+    soit n = (entier) x.size();
+    // Nombre de sorties, et position de la première dans le bloc
+    soit m  = (n + cnt) / R,
+         t0 = R - 1 - cnt;
+    assertion_msg((entier) y.size() >= m,
+        "Filtre virgule fixe : sortie trop petite ({} éléments, {} nécessaires).", y.size(), m);
+
+    // ext = [K-1 derniers échantillons, x] (x est recopié : traitement en place possible)
+    si((entier) ext.size() < K - 1 + n)
+      ext.resize(K - 1 + n);
+    memcpy(ext.data() + K - 1, x.data(), n * sizeof(T));
+
+    si((entier) acc.size() < m)
+      acc.resize(m);
+    memset(acc.data(), 0, m * sizeof(Tacc));
+    si(m > 0)
+      pour(auto r = 0; r < R; r++)
+        branche(branches[r], ext.data() + t0 + r, m);
+
+    fixe_sortie(acc.data(), y.data(), m, this->nb_bits_frac, this->stats);
+
+    cnt = (cnt + n) % R;
+    memmove(ext.data(), ext.data() + n, (K - 1) * sizeof(T));
+    retourne m;
+  }
+};
+
+template<typename T>
+sptr<FiltreFixe<T>> filtre_rif_fixe(const Vecf &h, entier nb_bits_frac)
+{
+  // Convolution : coefficients dans l'ordre inverse
+  soit K = h.rows();
+  Vecd c(K);
+  pour(auto k = 0; k < K; k++)
+    c(k) = h(K - 1 - k);
+  retourne make_shared<FiltreRIFFixe<T>>(c, 1, nb_bits_frac, "filtre_rif_fixe");
+}
+
+template<typename T>
+sptr<FiltreFixe<T>> filtre_rif_decim_fixe(const Vecf &h, entier R, entier nb_bits_frac)
+{
+  // (même ordre des coefficients que filtre_rif_decim())
+  retourne make_shared<FiltreRIFFixe<T>>(h.as<double>(), R, nb_bits_frac, "filtre_rif_decim_fixe");
+}
+
+/////////////////////////////////////////////////////////////////////////
+// Chaine de sections du second ordre en virgule fixe
+/////////////////////////////////////////////////////////////////////////
+
+/** @brief Chaine de sections du second ordre, virgule fixe (forme directe I)
+ *
+ *  Pour chaque section (coefficients sur B bits, Q(f)) :
+ *  @f[
+ *  acc = b_0 x_n + b_1 x_{n-1} + b_2 x_{n-2} - a_1 y_{n-1} - a_2 y_{n-2},\quad
+ *  y_n = \mathrm{sat}(\mathrm{arrondi}(acc / 2^f))
+ *  @f]
+ *  avec un accumulateur 64 bits (exact en Q15). État initial nul.
+ *
+ *  Les gains sont répartis entre les sections (norme L∞) : le numérateur de chaque section,
+ *  sauf la dernière, est mis à l'échelle de manière à ce que le gain maximal (sur toutes les fréquences)
+ *  de la chaine jusqu'à cette section soit unitaire. Un signal pleine échelle ne peut alors saturer
+ *  qu'en régime transitoire. */
+template<typename T>
+struct ChaineSOISFixe: FiltreFixe<T>
+{
+  struct Section
+  {
+    // b0, b1, b2, a1, a2 (Q(f))
+    int64_t c[5] = {0};
+    entier f = 0;
+    T x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+  };
+  vector<Section> sections;
+
+  ChaineSOISFixe(const Tabd &coefs, entier nb_bits_frac)
+  {
+    soit ns = coefs.cols();
+    si(ns == 0)
+      échec("filtre_sois_fixe : fonction de transfert vide.");
+
+    // Gain maximal de la chaine jusqu'à chaque section (grille de fréquences)
+    soit nf = 1024;
+    vector<cdouble> H(nf, 1.0);
+    Vecd G = Vecd::zeros(ns);
+    pour(auto s = 0; s < ns; s++)
+    {
+      pour(auto i = 0; i < nf; i++)
+      {
+        soit z1 = std::polar(1.0, -π * i / (nf - 1.0));
+        soit z2 = z1 * z1;
+        H[i] *= (coefs(0, s) + coefs(1, s) * z1 + coefs(2, s) * z2)
+              / (1.0 + coefs(3, s) * z1 + coefs(4, s) * z2);
+        G(s) = max(G(s), std::abs(H[i]));
+      }
+    }
+
+    constexpr entier B = FixeTraits<T>::nb_bits;
+    FiltreFixeStats st;
+    sections.resize(ns);
+    pour(auto s = 0; s < ns; s++)
+    {
+      soit g = (s == 0) ? 1.0 : G(s - 1);
+      si(s + 1 < ns)
+        g /= G(s);
+      Vecd c(5);
+      pour(auto j = 0; j < 5; j++)
+        c(j) = coefs(j, s) * ((j < 3) ? g : 1.0);
+      // (|a1| < 2 en général : au plus B-2 bits fractionnaires)
+      soit &sec = sections[s];
+      sec.f = fixe_bits_coefs<T>(c, nb_bits_frac, B - 2, 64, "filtre_sois_fixe");
+      pour(auto j = 0; j < 5; j++)
+        sec.c[j] = fixe_quantifie<T>(c(j), sec.f, st);
+    }
+    this->nb_bits_frac = sections[0].f;
+  }
+
+  entier dim_sortie_max(entier n) const override
+  {
+    retourne n;
+  }
+
+  size_t step(std::span<const T> x, std::span<T> y) override
+  {
+    assertion_msg(y.size() >= x.size(),
+        "Filtre virgule fixe : sortie trop petite ({} éléments, {} nécessaires).", y.size(), x.size());
+    soit n = x.size();
+    soit &st = this->stats;
+    pour(auto i = 0u; i < n; i++)
+    {
+      T v = x[i];
+      pour(auto &s: sections)
+      {
+        int64_t a = s.c[0] * v + s.c[1] * s.x1 + s.c[2] * s.x2 - s.c[3] * s.y1 - s.c[4] * s.y2;
+        st.max_abs_acc = max(st.max_abs_acc, (int64_t) std::abs(a));
+        s.x2 = s.x1;
+        s.x1 = v;
+        v = fixe_sature<T>(fixe_arrondi(a, s.f), st);
+        s.y2 = s.y1;
+        s.y1 = v;
+      }
+      y[i] = v;
+      st.max_abs_sortie = max(st.max_abs_sortie, (int64_t) std::abs((int64_t) v));
+    }
+    st.nb_échantillons += n;
+    retourne n;
+  }
+};
+
+template<typename T>
+sptr<FiltreFixe<T>> filtre_sois_fixe(const FRat<cfloat> &h, entier nb_bits_frac)
+{
+  retourne make_shared<ChaineSOISFixe<T>>(sois_coefs(h), nb_bits_frac);
+}
+
+template<typename T>
+sptr<FiltreFixe<T>> filtre_sois_fixe(const FRat<float> &h, entier nb_bits_frac)
+{
+  retourne make_shared<ChaineSOISFixe<T>>(sois_coefs(h), nb_bits_frac);
+}
+
+template void vers_fixe<int16_t>(std::span<const float> x, std::span<int16_t> y, entier nb_bits_frac);
+template void vers_fixe<int32_t>(std::span<const float> x, std::span<int32_t> y, entier nb_bits_frac);
+template void depuis_fixe<int16_t>(std::span<const int16_t> x, std::span<float> y, entier nb_bits_frac);
+template void depuis_fixe<int32_t>(std::span<const int32_t> x, std::span<float> y, entier nb_bits_frac);
+template sptr<FiltreFixe<int16_t>> filtre_rif_fixe<int16_t>(const Vecf &h, entier nb_bits_frac);
+template sptr<FiltreFixe<int32_t>> filtre_rif_fixe<int32_t>(const Vecf &h, entier nb_bits_frac);
+template sptr<FiltreFixe<int16_t>> filtre_rif_decim_fixe<int16_t>(const Vecf &h, entier R, entier nb_bits_frac);
+template sptr<FiltreFixe<int32_t>> filtre_rif_decim_fixe<int32_t>(const Vecf &h, entier R, entier nb_bits_frac);
+template sptr<FiltreFixe<int16_t>> filtre_sois_fixe<int16_t>(const FRat<cfloat> &h, entier nb_bits_frac);
+template sptr<FiltreFixe<int32_t>> filtre_sois_fixe<int32_t>(const FRat<cfloat> &h, entier nb_bits_frac);
+template sptr<FiltreFixe<int16_t>> filtre_sois_fixe<int16_t>(const FRat<float> &h, entier nb_bits_frac);
+template sptr<FiltreFixe<int32_t>> filtre_sois_fixe<int32_t>(const FRat<float> &h, entier nb_bits_frac);
+
+}
@@ -2,6 +2,9 @@
 #include "tsd/filtrage.hpp"
 #include "tsd/fourier.hpp"
 #include <set>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 using namespace tsd::fourier;
@@ -9,6 +12,19 @@ using namespace tsd::fourier;
 namespace tsd::filtrage
 {
 
+// Traitement d'un bloc directement dans la mémoire de l'appelant,
+// par une boucle sur step_éch() (appel non virtuel ; traitement en place possible)
+#define STEP_SPAN_PAR_ECH(CLASSE)                                                          \
+  std::size_t step(std::span<const T> x, std::span<T> y) override                          \
+  {                                                                                        \
+    assertion_msg(y.size() >= x.size(),                                                    \
+        "Filtre : sortie trop petite ({} éléments, {} nécessaires).", y.size(), x.size()); \
+    soit n = x.size();                                                                     \
+    pour(auto i = 0u; i < n; i++)                                                          \
+      y[i] = CLASSE::step_éch(x[i]);                                                       \
+    retourne n;                                                                            \
+  }
+
 
 template<typename T>
 struct LigneARetard: FiltreGen<T>
@@ -23,6 +39,18 @@ struct LigneARetard: FiltreGen<T>
     msg("ligne à retard : retard = {} échantillons.", retard);
   }
 
+  STEP_SPAN_PAR_ECH(LigneARetard)
+
+  T step_éch(T x)
+  {
+    si(retard == 0)
+      retourne x;
+    soit y = fenetre(ri);
+    fenetre(ri) = x;
+    ri = (ri + 1) % retard;
+    retourne y;
+  }
+
   void step(const Vecteur<T> &x, Vecteur<T> &y)
   {
     si(retard == 0)
@@ -35,11 +63,7 @@ struct LigneARetard: FiltreGen<T>
     y.resize(n);
 
     pour(auto i = 0; i < n; i++)
-    {
-      y(i) = fenetre(ri);
-      fenetre(ri) = x(i);
-      ri = (ri + 1) % retard;
-    }
+      y(i) = LigneARetard::step_éch(x(i));
   }
 
 };
@@ -50,61 +74,369 @@ template<typename T>
   retourne make_shared<LigneARetard<T>>(retard);
 }
 
+/////////////////////////////////////////////////////////////////////////
+// Noyaux RIF par bloc
+/////////////////////////////////////////////////////////////////////////
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define TSD_RIF_SIMD 1
+#else
+# define TSD_RIF_SIMD 0
+#endif
+
+// Modes des noyaux par bloc
+enum RifMode
+{
+  RIF_AFFECTE = 0, // y  = somme_k h[k] a[i + S.k]
+  RIF_ACCUMULE,    // y += somme_k h[k] a[i + S.k]
+  RIF_REPLIÉ_SYM,  // y += somme_k h[k] (a[i + S.k] + b[i - S.k])
+  RIF_REPLIÉ_ASYM  // y += somme_k h[k] (a[i + S.k] - b[i - S.k])
+};
+
+/** @brief Noyau RIF par bloc (cf. RifMode), pour i = 0 ... m-1
+ *
+ *  S = 1 : données réelles, S = 2 : données complexes entrelacées (coefficients réels),
+ *  S = 0 : pas quelconque (paramètre pas), par exemple plusieurs canaux entrelacés.
+ *  Les sorties sont calculées par paquets de 4 vecteurs de W flottants : chaque coefficient
+ *  chargé sert à 4W sorties, et les accumulateurs restent dans les registres.
+ *  En mode replié (filtre à phase linéaire), le pré-additionneur a ± b
+ *  divise par deux le nombre de multiplications. */
+template<entier S, entier W, entier MODE>
+static inline void rif_bloc_noyau(const float *h, entier K, const float *a, const float *b,
+                                  float *y, entier m, entier pas = S)
+{
+  typedef float vf __attribute__((vector_size(4 * W)));
+  si constexpr(S > 0)
+    pas = S;
+
+  // Combinaison des deux entrées (mode replié)
+  soit combine = [&](vf &u, const float *bp)
+  {
+    si constexpr(MODE >= RIF_REPLIÉ_SYM)
+    {
+      vf v;
+      memcpy(&v, bp, sizeof(vf));
+      si constexpr(MODE == RIF_REPLIÉ_SYM)
+        u += v;
+      sinon
+        u -= v;
+    }
+  };
+
+  entier i0 = 0;
+  pour(; i0 + 4 * W <= m; i0 += 4 * W)
+  {
+    vf a0 = {}, a1 = {}, a2 = {}, a3 = {}, v0, v1, v2, v3;
+    si constexpr(MODE != RIF_AFFECTE)
+    {
+      memcpy(&a0, y + i0,         sizeof(vf));
+      memcpy(&a1, y + i0 + W,     sizeof(vf));
+      memcpy(&a2, y + i0 + 2 * W, sizeof(vf));
+      memcpy(&a3, y + i0 + 3 * W, sizeof(vf));
+    }
+    soit ap = a + i0, bp = b + i0;
+    pour(auto k = 0; k < K; k++, ap += pas, bp -= pas)
+    {
+      memcpy(&v0, ap,         sizeof(vf));
+      memcpy(&v1, ap + W,     sizeof(vf));
+      memcpy(&v2, ap + 2 * W, sizeof(vf));
+      memcpy(&v3, ap + 3 * W, sizeof(vf));
+      combine(v0, bp);
+      combine(v1, bp + W);
+      combine(v2, bp + 2 * W);
+      combine(v3, bp + 3 * W);
+      soit c = h[k];
+      a0 += c * v0;
+      a1 += c * v1;
+      a2 += c * v2;
+      a3 += c * v3;
+    }
+    memcpy(y + i0,         &a0, sizeof(vf));
+    memcpy(y + i0 + W,     &a1, sizeof(vf));
+    memcpy(y + i0 + 2 * W, &a2, sizeof(vf));
+    memcpy(y + i0 + 3 * W, &a3, sizeof(vf));
+  }
+  pour(; i0 + W <= m; i0 += W)
+  {
+    vf a0 = {}, v0;
+    si constexpr(MODE != RIF_AFFECTE)
+      memcpy(&a0, y + i0, sizeof(vf));
+    soit ap = a + i0, bp = b + i0;
+    pour(auto k = 0; k < K; k++, ap += pas, bp -= pas)
+    {
+      memcpy(&v0, ap, sizeof(vf));
+      combine(v0, bp);
+      a0 += h[k] * v0;
+    }
+    memcpy(y + i0, &a0, sizeof(vf));
+  }
+  pour(; i0 < m; i0++)
+  {
+    float s = (MODE == RIF_AFFECTE) ? 0 : y[i0];
+    pour(auto k = 0; k < K; k++)
+    {
+      float u = a[i0 + pas * k];
+      si constexpr(MODE == RIF_REPLIÉ_SYM)
+        u += b[i0 - pas * k];
+      sinon si constexpr(MODE == RIF_REPLIÉ_ASYM)
+        u -= b[i0 - pas * k];
+      s += h[k] * u;
+    }
+    y[i0] = s;
+  }
+}
+
+#if TSD_RIF_SIMD
+template<entier S, entier MODE>
+__attribute__((target("avx2,fma"), flatten))
+static void rif_bloc_avx2(const float *h, entier K, const float *a, const float *b, float *y, entier m, entier pas)
+{
+  rif_bloc_noyau<S, 8, MODE>(h, K, a, b, y, m, pas);
+}
+
+template<entier S, entier MODE>
+__attribute__((target("avx512f"), flatten))
+static void rif_bloc_avx512(const float *h, entier K, const float *a, const float *b, float *y, entier m, entier pas)
+{
+  rif_bloc_noyau<S, 16, MODE>(h, K, a, b, y, m, pas);
+}
+#endif
+
+template<entier S, entier MODE>
+static void rif_bloc_simd(const float *h, entier K, const float *a, const float *b, float *y, entier m,
+                          entier pas = S)
+{
+# if TSD_RIF_SIMD
+  soit niveau = tfr_simd_niveau();
+  si(niveau == 3)
+    retourne rif_bloc_avx512<S, MODE>(h, K, a, b, y, m, pas);
+  si(niveau == 2)
+    retourne rif_bloc_avx2<S, MODE>(h, K, a, b, y, m, pas);
+# endif
+  rif_bloc_noyau<S, 4, MODE>(h, K, a, b, y, m, pas);
+}
+
+template<entier MODE>
+static void rif_bloc_simd(const float *h, entier K, const float *a, const float *b, float *y, entier m, entier S)
+{
+  si(S == 1)
+    rif_bloc_simd<1, MODE>(h, K, a, b, y, m);
+  sinon si(S == 2)
+    rif_bloc_simd<2, MODE>(h, K, a, b, y, m);
+  sinon
+    rif_bloc_simd<0, MODE>(h, K, a, b, y, m, S);
+}
+
+void rif_bloc(const float *h, entier K, const float *x, float *y, entier m, entier S, bouléen accumule)
+{
+  si(accumule)
+    rif_bloc_simd<RIF_ACCUMULE>(h, K, x, x, y, m, S);
+  sinon
+    rif_bloc_simd<RIF_AFFECTE>(h, K, x, x, y, m, S);
+}
+
+void rif_bloc_replié(const float *h, entier Q, const float *a, const float *b,
+                     float *y, entier m, entier S, bouléen anti)
+{
+  si(anti)
+    rif_bloc_simd<RIF_REPLIÉ_ASYM>(h, Q, a, b, y, m, S);
+  sinon
+    rif_bloc_simd<RIF_REPLIÉ_SYM>(h, Q, a, b, y, m, S);
+}
+
+template<typename Tc>
+static entier rif_symétrie_impl(const Vecteur<Tc> &h)
+{
+  soit K = h.rows();
+  bouléen sym = oui, anti = oui;
+  pour(auto k = 0; k < K; k++)
+  {
+    sym  = sym  && (h(k) ==  h(K-1-k));
+    anti = anti && (h(k) == -h(K-1-k));
+  }
+  retourne sym ? 1 : (anti ? -1 : 0);
+}
+
+entier rif_symétrie(const Vecf &h)
+{
+  retourne rif_symétrie_impl(h);
+}
+
+entier rif_symétrie(const Veccf &h)
+{
+  retourne rif_symétrie_impl(h);
+}
+
+template<typename Tc>
+static Vecteur<Tc> rif_coefs_repliés_impl(const Vecteur<Tc> &h, entier symétrie)
+{
+  soit K = h.rows();
+  si(symétrie < 0)
+    retourne h.head(K / 2).clone();
+  Vecteur<Tc> hr = h.head((K + 1) / 2).clone();
+  // Le coefficient central est compté deux fois par le pré-additionneur
+  si(est_impair(K))
+    hr(K / 2) *= 0.5f;
+  retourne hr;
+}
+
+Vecf rif_coefs_repliés(const Vecf &h, entier symétrie)
+{
+  retourne rif_coefs_repliés_impl(h, symétrie);
+}
+
+Veccf rif_coefs_repliés(const Veccf &h, entier symétrie)
+{
+  retourne rif_coefs_repliés_impl(h, symétrie);
+}
+
 template<typename T, typename Tc>
 struct FiltreRIF: FiltreGen<T>
 {
-  Vecteur<T> fen;
-  entier index = 0, K = 0;
-  Vecteur<Tc> coefs;
+  // Type de données et de coefficients supportés par les noyaux par bloc
+  static constexpr bouléen avec_bloc =
+      (std::is_same_v<T, float> && std::is_same_v<Tc, float>)
+   || (std::is_same_v<T, cfloat> && (std::is_same_v<Tc, float> || std::is_same_v<Tc, cfloat>));
+
+  // En dessous, traitement échantillon par échantillon
+  static const entier DIM_BLOC_MIN = 8;
+
+  // Ligne à retard de longueur double : chaque échantillon est écrit en p et p + K,
+  // la fenêtre (dans l'ordre chronologique) est donc toujours contigüe : ligne[p ... p+K-1].
+  Vecteur<T> ligne;
+  entier p = 0, K = 0;
+  // Coefficients dans l'ordre inverse (le plus ancien échantillon en premier)
+  Vecteur<Tc> coefs_inv;
+  Vecf coefs_re, coefs_im;
+  // Phase linéaire (1 : coefficients symétriques, -1 : anti-symétriques, 0 : quelconques) :
+  // coefs_inv est alors replié (Q premiers coefficients, cf. rif_coefs_repliés()).
+  entier symétrie = 0, Q = 0;
+  // Historique + bloc d'entrée, et tampon de calcul (complexe x complexe)
+  Vecteur<T> ext, tmp;
 
   FiltreRIF(const Vecteur<Tc> &c)
   {
-    this->coefs = c;
     K = c.rows();
-    fen.setZero(K);
+    coefs_inv = c.reverse();
+    ligne.setZero(2 * K);
+    si(K >= 4)
+      symétrie = rif_symétrie(c);
+    Q = K;
+    si(symétrie != 0)
+    {
+      coefs_inv = rif_coefs_repliés(coefs_inv, symétrie);
+      Q = coefs_inv.rows();
+    }
+    si constexpr(std::is_same_v<Tc, cfloat>)
+    {
+      coefs_re = real(coefs_inv);
+      coefs_im = imag(coefs_inv);
+    }
   }
 
   void step(const Vecteur<T> &x, Vecteur<T> &y)
   {
     assertion(K > 0);
-    soit n    = x.rows();
-    soit iptr = x.data();
-    soit optr = y.data();
+    soit n = x.rows();
+    si(x.data() != y.data())
+      y.resize(n);
+    step_ptr(x.data(), y.data(), n);
+  }
 
-    //msg("filtre rif: iptr={}, optr={}", (int64_t) iptr, (int64_t) optr);
+  std::size_t step(std::span<const T> x, std::span<T> y) override
+  {
+    assertion_msg(y.size() >= x.size(),
+        "Filtre RIF : sortie trop petite ({} éléments, {} nécessaires).", y.size(), x.size());
+    step_ptr(x.data(), y.data(), x.size());
+    retourne x.size();
+  }
 
-    si(iptr != optr)
+  // (x et y peuvent être la même zone mémoire)
+  void step_ptr(const T *x, T *y, entier n)
+  {
+    si constexpr(avec_bloc)
     {
-      y.resize(n);
-      optr = y.data();
+      si(n >= DIM_BLOC_MIN)
+      {
+        step_bloc(x, y, n);
+        retourne;
+      }
     }
-
     pour(auto j = 0; j < n; j++)
+      y[j] = FiltreRIF::step_éch(x[j]);
+  }
+
+  void step_bloc(const T *x, T *y, entier n)
+  {
+    // ext = [K-1 derniers échantillons, x]
+    ext.resize(K - 1 + n);
+    memcpy(ext.data(), ligne.data() + p + 1, (K - 1) * sizeof(T));
+    memcpy(ext.data() + K - 1, x, n * sizeof(T));
+
+    constexpr entier S = std::is_same_v<T, float> ? 1 : 2;
+    soit e = (const float *) ext.data();
+    soit o = (float *) y;
+
+    // o = somme_k h[k] e[i + S.k], ou en repliant les coefficients :
+    // o = somme_{k < Q} h[k] (e[i + S.k] ± e[i + S.(K-1-k)])
+    soit filtre = [&](const float *h, float *dst)
     {
-      soit cptr = coefs.data() + (K - 1);
+      si(symétrie == 0)
+        rif_bloc(h, K, e, dst, S * n, S, non);
+      sinon
+      {
+        memset(dst, 0, n * sizeof(T));
+        rif_bloc_replié(h, Q, e, e + S * (K - 1), dst, S * n, S, symétrie < 0);
+      }
+    };
 
-      T somme = 0;
+    si constexpr(!std::is_same_v<Tc, cfloat>)
+      filtre(coefs_inv.data(), o);
+    sinon
+    {
+      // h = hr + i.hi : y = (hr * x) + i.(hi * x)
+      tmp.resize(n);
+      soit t = (float *) tmp.data();
+      filtre(coefs_re.data(), o);
+      filtre(coefs_im.data(), t);
+      pour(auto j = 0; j < n; j++)
+      {
+        o[2*j]   -= t[2*j+1];
+        o[2*j+1] += t[2*j];
+      }
+    }
 
-      // Remplace le plus ancien élément
-      fen(index) = *iptr++;
-      index = (index + 1) % K;
-      soit fptr = fen.data() + index;
+    // Nouvel état : les K derniers échantillons
+    memcpy(ligne.data(),     ext.data() + n - 1, K * sizeof(T));
+    memcpy(ligne.data() + K, ext.data() + n - 1, K * sizeof(T));
+    p = 0;
+  }
 
-      // Number of samples at end of delay line
-      soit K1 = K - index;
-      // Number at begin of delay line
-      soit K2 = K - K1;
+  T step_éch(T x)
+  {
+    // Remplace le plus ancien élément
+    ligne(p) = ligne(p + K) = x;
+    p = (p + 1 == K) ? 0 : p + 1;
 
-      pour(auto i = 0; i < K1; i++)
-        somme += *fptr++ * *cptr--;
+    soit w = ligne.data() + p;
+    soit c = coefs_inv.data();
 
-      // Restart at beginning of delay line
-      fptr = fen.data();
-      pour(auto i = 0; i < K2; i++)
-        somme += *fptr++ * *cptr--;
+    si(symétrie != 0)
+      retourne rif_produit_replié(c, w, K, symétrie);
 
-      *optr++ = somme;
+    // Produit scalaire contigu, 4 accumulateurs
+    T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    entier k = 0;
+    pour(; k + 4 <= K; k += 4)
+    {
+      s0 += w[k]   * c[k];
+      s1 += w[k+1] * c[k+1];
+      s2 += w[k+2] * c[k+2];
+      s3 += w[k+3] * c[k+3];
     }
+    pour(; k < K; k++)
+      s0 += w[k] * c[k];
+    retourne (s0 + s1) + (s2 + s3);
   }
 };
 
@@ -132,6 +464,10 @@ struct Decimateur: FiltreGen<T, T>
   {
     this->R = R;
   }
+  entier dim_sortie_max(entier n) const
+  {
+    retourne (n + R - 1) / R;
+  }
   void step(const Vecteur<T> &x, Vecteur<T> &y)
   {
     soit n = x.rows();
@@ -279,7 +615,47 @@ struct FiltreRII: FiltreGen<T>
     }
   }
 
+  STEP_SPAN_PAR_ECH(FiltreRII)
+
+  // Mêmes calculs que step(), pour un seul échantillon
+  T step_éch(T x)
+  {
+    // (1) Filtre non récursif
+    soit nptr = numer.data() + (Kx - 1);
+    T somme = 0;
+
+    wndx(index) = x;
+    index = (index + 1) % Kx;
+    soit wptr = wndx.data() + index;
+
+    soit KK1 = Kx - index;
+    soit KK2 = Kx - KK1;
+
+    pour(auto i = 0; i < KK1; i++)
+      somme += *wptr++ * *nptr--;
+    wptr = wndx.data();
+    pour(auto i = 0; i < KK2; i++)
+      somme += *wptr++ * *nptr--;
 
+    // (2) Filtre récursif
+    soit dptr = denom.data() + 1;
+    wptr = wndy.data() + index_y;
+
+    KK1 = Ky - index_y;
+    KK2 = Ky - KK1;
+
+    pour(auto i = 0; i < KK1; i++)
+      somme -= *wptr++ * *dptr++;
+    wptr = wndy.data();
+    pour(auto i = 0; i < KK2; i++)
+      somme -= *wptr++ * *dptr++;
+
+    T y = somme / denom(0);
+
+    index_y = (index_y + Ky - 1) % Ky;
+    wndy(index_y) = y;
+    retourne y;
+  }
 };
 
 template<typename Tc, typename T>
@@ -396,7 +772,36 @@ struct SOIS: Filtre<T, T, SOISConfig>
       échec("SOIS : structure non implémentée.");
   }
 
+  STEP_SPAN_PAR_ECH(SOIS)
 
+  T step_éch(T x)
+  {
+    si(premier_appel)
+    {
+      y0 = y1 = y2 = x2 = x1 = x;
+      premier_appel = non;
+    }
+
+    Ty x0 = x;
+    si(structure == RIIStructure::FormeDirecte2)
+    {
+      soit d2 = x0 - a1 * y1 - a2 * y0;
+      y2 = b0 * d2 + b1 * y1 + b2 * y0;
+      y0 = y1;
+      y1 = d2;
+      retourne (T) y2;
+    }
+    sinon si(structure == RIIStructure::FormeDirecte1)
+    {
+      y0  = b0 * x0 + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+      y2 = y1;
+      y1 = y0;
+      x2 = x1;
+      x1 = x0;
+      retourne (T) y0;
+    }
+    échec("SOIS : structure non implémentée.");
+  }
 };
 
 
@@ -434,6 +839,13 @@ struct RIIFoS: FiltreGen<T>
       //msg("k={}, x={}, y={}", i, x(i), y(i));
     }
   }
+
+  T step_éch(T x0)
+  {
+    y1 = -a1 * y1 + b0 * x0 + b1 * x1;
+    x1 = x0;
+    retourne y1;
+  }
 };
 
 
@@ -561,14 +973,25 @@ struct ChaineSOIS: FiltreGen<T>
 
   void step(const Vecteur<T> &x, Vecteur<T> &y)
   {
-    y = x.clone();
+    // (sections traitées en place)
+    si(x.data() != y.data())
+      y = x.clone();
     pour(auto &s: sections)
-      y = s.FiltreGen<T>::step(y);
+      s.step(y, y);
     si(avec_rii1)
-      y = rii1.FiltreGen<T>::step(y);
+      rii1.step(y, y);
     sinon
       y *= gain;
   }
+
+  T step_éch(T x)
+  {
+    pour(auto &s: sections)
+      x = s.step_éch(x);
+    si(avec_rii1)
+      retourne rii1.step_éch(x);
+    retourne x * gain;
+  }
 };
 
 template<typename T>
@@ -577,8 +1000,8 @@ sptr<FiltreGen<T>> filtre_sois(const FRat<cfloat> &h, RIIStructure structure)
   retourne make_shared<ChaineSOIS<T,T,T>>(h, structure);
 }
 
-template<typename T>
-sptr<FiltreGen<T>> filtre_sois(const FRat<float> &h, RIIStructure structure)
+// Fonction de transfert réelle -> forme pôles / zéros complexe (factorisation en sections)
+static FRat<cfloat> sois_frat_complexe(const FRat<float> &h)
 {
   soit &numer = h.numer, &denom = h.denom;
 
@@ -596,9 +1019,752 @@ sptr<FiltreGen<T>> filtre_sois(const FRat<float> &h, RIIStructure structure)
   si(!denom.mode_racines)
     h2.denom = Poly<cfloat>::from_roots(denom.roots())
                 * denom.coefs(denom.coefs.rows() - 1);
+  retourne h2;
+}
+
+template<typename T>
+sptr<FiltreGen<T>> filtre_sois(const FRat<float> &h, RIIStructure structure)
+{
+  retourne make_shared<ChaineSOIS<T,T,T>>(sois_frat_complexe(h), structure);
+}
+
+Tabd sois_coefs(const FRat<cfloat> &h)
+{
+  ChaineSOIS<float, float, float> chaine(h, FormeDirecte1);
+  soit ns = (entier) chaine.sections.size();
+  Tabd res = Tabd::zeros(5, max(ns + (chaine.avec_rii1 ? 1 : 0), (entier) 1));
+  pour(auto i = 0; i < ns; i++)
+  {
+    soit &s = chaine.sections[i];
+    res(0, i) = s.b0;
+    res(1, i) = s.b1;
+    res(2, i) = s.b2;
+    res(3, i) = s.a1;
+    res(4, i) = s.a2;
+  }
+  si(chaine.avec_rii1)
+  {
+    soit &r = chaine.rii1;
+    res(0, ns) = r.b0;
+    res(1, ns) = r.b1;
+    res(3, ns) = r.a1;
+  }
+  // Gain appliqué au numérateur de la dernière section
+  sinon si(ns > 0)
+  {
+    pour(auto j = 0; j < 3; j++)
+      res(j, ns - 1) *= chaine.gain;
+  }
+  sinon
+    res(0, 0) = chaine.gain;
+  retourne res;
+}
+
+Tabd sois_coefs(const FRat<float> &h)
+{
+  retourne sois_coefs(sois_frat_complexe(h));
+}
+
+/////////////////////////////////////////////////////////////////////////
+// RII par bloc (représentation d'état)
+/////////////////////////////////////////////////////////////////////////
+
+/** @brief Représentation d'état d'un filtre RII (calculs en double précision) :
+ *  @f[
+ *  s_{n+1} = A s_n + B x_n,\quad y_n = C s_n + D x_n
+ *  @f]
+ *  L'état initial est init . x_0 (x_0 : première entrée) : comme pour les sections SOIS
+ *  (init = 1 pour toutes les composantes), ou nul. */
+template<typename Td>
+struct RIIEtats
+{
+  entier N = 0;
+  // A : N x N (par lignes)
+  vector<Td> A, B, C;
+  Td D = 1;
+  vector<Td> init;
+
+  RIIEtats(entier N = 0, Td D = 1): N(N), A(N * N, Td(0)), B(N, Td(0)), C(N, Td(0)), D(D), init(N, Td(0)){}
+
+  Td &a(entier i, entier j){retourne A[i * N + j];}
+
+  /** Changement de base : (s_i, s_{i+1}) -> (s_i, s_i - s_{i+1}) (matrice P, avec P = P^-1).
+   *  Pour deux composantes successives d'une même ligne à retard, la différence est petite devant les
+   *  composantes (pôles proches de 1) : elle est ainsi représentée directement (en flottant), et les
+   *  calculs par bloc (A^L, C.A^i) ne font plus apparaitre de grands termes qui se compensent. */
+  void différence(entier i)
+  {
+    // A' = P.A.P, B' = P.B, C' = C.P
+    pour(auto j = 0; j < N; j++)
+      a(i + 1, j) = a(i, j) - a(i + 1, j);
+    pour(auto k = 0; k < N; k++)
+    {
+      a(k, i) += a(k, i + 1);
+      a(k, i + 1) = -a(k, i + 1);
+    }
+    B[i + 1]    = B[i] - B[i + 1];
+    init[i + 1] = init[i] - init[i + 1];
+    C[i]       += C[i + 1];
+    C[i + 1]    = -C[i + 1];
+  }
 
+  // Mise en cascade : ce système, puis e
+  void cascade(const RIIEtats &e)
+  {
+    soit N2 = N + e.N;
+    vector<Td> A2(N2 * N2, Td(0)), B2(N2), C2(N2), init2(N2);
+    pour(auto i = 0; i < N; i++)
+    {
+      pour(auto j = 0; j < N; j++)
+        A2[i * N2 + j] = A[i * N + j];
+      B2[i] = B[i];
+      C2[i] = e.D * C[i];
+      init2[i] = init[i];
+    }
+    pour(auto i = 0; i < e.N; i++)
+    {
+      pour(auto j = 0; j < N; j++)
+        A2[(N + i) * N2 + j] = e.B[i] * C[j];
+      pour(auto j = 0; j < e.N; j++)
+        A2[(N + i) * N2 + N + j] = e.A[i * e.N + j];
+      B2[N + i] = e.B[i] * D;
+      C2[N + i] = e.C[i];
+      init2[N + i] = e.init[i];
+    }
+    N = N2;
+    A = A2;
+    B = B2;
+    C = C2;
+    D = e.D * D;
+    init = init2;
+  }
+};
 
-  retourne make_shared<ChaineSOIS<T,T,T>>(h2, structure);
+/** @brief Produit matrice - vecteur pour le RII par bloc : y (+)= M.v
+ *
+ *  M : m lignes, nv colonnes (stockage par colonnes, pas de ld flottants).
+ *  Les lignes sont traitées par vecteurs de W flottants, avec 4 accumulateurs par vecteur
+ *  (colonnes k mod 4) pour masquer la latence des multiplications-accumulations ;
+ *  les lignes restantes sont traitées avec des vecteurs plus petits. */
+template<entier W>
+static inline void rii_mv_noyau(const float *M, entier ld, entier m, const float *v, entier nv,
+                                float *y, bouléen accumule)
+{
+  typedef float vf __attribute__((vector_size(4 * W)));
+  entier i0 = 0;
+  pour(; i0 + W <= m; i0 += W)
+  {
+    vf a[4] = {}, u;
+    si(accumule)
+      memcpy(&a[0], y + i0, sizeof(vf));
+    soit mp = M + i0;
+    entier k = 0;
+    pour(; k + 4 <= nv; k += 4, mp += 4 * ld)
+    {
+      pour(auto j = 0; j < 4; j++)
+      {
+        memcpy(&u, mp + j * ld, sizeof(vf));
+        a[j] += v[k + j] * u;
+      }
+    }
+    pour(; k < nv; k++, mp += ld)
+    {
+      memcpy(&u, mp, sizeof(vf));
+      a[0] += v[k] * u;
+    }
+    a[0] += a[1] + a[2] + a[3];
+    memcpy(y + i0, &a[0], sizeof(vf));
+  }
+  si(i0 == m)
+    retourne;
+  si constexpr(W > 4)
+    rii_mv_noyau<W / 2>(M + i0, ld, m - i0, v, nv, y + i0, accumule);
+  sinon
+  {
+    pour(; i0 < m; i0++)
+    {
+      float s = accumule ? y[i0] : 0.0f;
+      pour(auto k = 0; k < nv; k++)
+        s += M[i0 + k * ld] * v[k];
+      y[i0] = s;
+    }
+  }
+}
+
+#if TSD_RIF_SIMD
+__attribute__((target("avx2,fma"), flatten))
+static void rii_mv_avx2(const float *M, entier m, const float *v, entier nv, float *y, bouléen accumule)
+{
+  rii_mv_noyau<8>(M, m, m, v, nv, y, accumule);
+}
+
+__attribute__((target("avx512f"), flatten))
+static void rii_mv_avx512(const float *M, entier m, const float *v, entier nv, float *y, bouléen accumule)
+{
+  rii_mv_noyau<16>(M, m, m, v, nv, y, accumule);
+}
+#endif
+
+static void rii_mv(entier niveau, const float *M, entier m, const float *v, entier nv, float *y, bouléen accumule)
+{
+# if TSD_RIF_SIMD
+  si(niveau == 3)
+    retourne rii_mv_avx512(M, m, v, nv, y, accumule);
+  si(niveau == 2)
+    retourne rii_mv_avx2(M, m, v, nv, y, accumule);
+# endif
+  rii_mv_noyau<4>(M, m, m, v, nv, y, accumule);
+}
+
+/** @brief Filtre RII par bloc de L échantillons, à partir de la représentation d'état
+ *  (voir @ref filtre_sois_bloc())
+ *
+ *  Avec v = (s, x_0, ..., x_{L-1}) :
+ *  y = [O | H].v, avec O (lignes C.A^i) et H la matrice de Toeplitz triangulaire
+ *  formée de la réponse impulsionnelle h_0 = D, h_i = C.A^{i-1}.B,
+ *  puis s = [A^L | G].v (colonnes de G : A^{L-1-j}.B).
+ *  Il n'y a donc plus de dépendance d'un échantillon au précédent : deux produits matrice - vecteur par bloc.
+ *
+ *  Données complexes : deux plans (parties réelles et imaginaires) ;
+ *  coefficients complexes : quatre produits réels. */
+template<typename T, typename Tc>
+struct FiltreRIIBloc: FiltreGen<T>
+{
+  using Td = typename std::conditional<est_complexe<Tc>(), cdouble, double>::type;
+  static constexpr bouléen coefs_complexes = est_complexe<Tc>();
+  static constexpr entier nb_plans = est_complexe<T>() ? 2 : 1;
+
+  // Etages en cascade (pour l'initialisation)
+  vector<RIIEtats<Td>> étages;
+  entier N = 0, L = 0;
+  // Représentation d'état (échantillon par échantillon), A par lignes
+  Vecteur<Tc> A, B, C;
+  Tc D = 0;
+  // Matrices par bloc, par colonnes : M = [O | H] (L lignes), M2 = [A^L | G] (N lignes)
+  // (parties réelles, imaginaires, et opposées des parties imaginaires)
+  Vecf M[3], M2[3];
+  // v = (s, x), sorties, et état suivant (par plan)
+  Vecf v[2], yb[2], st[2];
+  Vecteur<T> s2;
+  bouléen premier_appel = oui;
+  entier niveau = 0;
+
+  FiltreRIIBloc(const vector<RIIEtats<Td>> &étages, entier dim_bloc)
+  {
+    this->étages = étages;
+    RIIEtats<Td> e;
+    pour(auto &étage: étages)
+      e.cascade(étage);
+    N = e.N;
+
+    // Coût par échantillon ~ 2N + L + N²/L
+    L = dim_bloc;
+    si(L <= 0)
+      L = max((entier) 16, prochaine_puissance_de_2(N));
+
+    A.resize(N * N);
+    B.resize(N);
+    C.resize(N);
+    pour(auto i = 0; i < N * N; i++)
+      A(i) = (Tc) e.A[i];
+    pour(auto i = 0; i < N; i++)
+    {
+      B(i) = (Tc) e.B[i];
+      C(i) = (Tc) e.C[i];
+    }
+    D = (Tc) e.D;
+
+    vector<Td> m1((N + L) * L, Td(0)), m2((N + L) * N, Td(0));
+
+    // O (P = C.A^i), et réponse impulsionnelle (colonnes de H)
+    vector<Td> P = e.C, P2(N), h(L);
+    h[0] = e.D;
+    pour(auto i = 0; i < L; i++)
+    {
+      Td hi = 0;
+      pour(auto k = 0; k < N; k++)
+      {
+        m1[k * L + i] = P[k];
+        hi += P[k] * e.B[k];
+      }
+      si(i + 1 < L)
+        h[i + 1] = hi;
+      pour(auto k = 0; k < N; k++)
+      {
+        P2[k] = 0;
+        pour(auto j = 0; j < N; j++)
+          P2[k] += P[j] * e.A[j * N + k];
+      }
+      P = P2;
+    }
+    pour(auto j = 0; j < L; j++)
+      pour(auto i = j; i < L; i++)
+        m1[(N + j) * L + i] = h[i - j];
+
+    // A^L (colonne k : A^L.e_k) et G (colonne j : A^{L-1-j}.B)
+    vector<Td> v2(N);
+    soit mult = [&](vector<Td> &u)
+    {
+      pour(auto i = 0; i < N; i++)
+      {
+        v2[i] = 0;
+        pour(auto j = 0; j < N; j++)
+          v2[i] += e.A[i * N + j] * u[j];
+      }
+      u = v2;
+    };
+    pour(auto k = 0; k < N; k++)
+    {
+      vector<Td> u(N, Td(0));
+      u[k] = 1;
+      pour(auto r = 0; r < L; r++)
+        mult(u);
+      pour(auto i = 0; i < N; i++)
+        m2[k * N + i] = u[i];
+    }
+    vector<Td> u = e.B;
+    pour(auto j = L - 1; j >= 0; j--)
+    {
+      pour(auto i = 0; i < N; i++)
+        m2[(N + j) * N + i] = u[i];
+      mult(u);
+    }
+
+    soit conv = [&](const vector<Td> &m, Vecf *res)
+    {
+      soit n = (entier) m.size();
+      pour(auto p = 0; p < (coefs_complexes ? 3 : 1); p++)
+        res[p].resize(n);
+      pour(auto i = 0; i < n; i++)
+      {
+        si constexpr(coefs_complexes)
+        {
+          res[0](i) =  m[i].real();
+          res[1](i) =  m[i].imag();
+          res[2](i) = -m[i].imag();
+        }
+        sinon
+          res[0](i) = m[i];
+      }
+    };
+    conv(m1, M);
+    conv(m2, M2);
+
+    pour(auto p = 0; p < nb_plans; p++)
+    {
+      v[p].setZero(N + L);
+      yb[p].setZero(L);
+      st[p].setZero(N);
+    }
+    s2.resize(N);
+#   if TSD_RIF_SIMD
+    niveau = tfr_simd_niveau();
+#   endif
+  }
+
+  T état(entier i) const
+  {
+    si constexpr(nb_plans == 2)
+      retourne T(v[0](i), v[1](i));
+    sinon
+      retourne v[0](i);
+  }
+
+  void état_écrit(entier i, T x)
+  {
+    si constexpr(nb_plans == 2)
+    {
+      v[0](i) = x.real();
+      v[1](i) = x.imag();
+    }
+    sinon
+      v[0](i) = x;
+  }
+
+  // Etat initial (sections SOIS : chaque étage est initialisé avec sa première entrée)
+  void init(T x0)
+  {
+    T u = x0;
+    entier i0 = 0;
+    pour(auto &e: étages)
+    {
+      T y = (Tc) e.D * u;
+      pour(auto i = 0; i < e.N; i++)
+      {
+        T si0 = (Tc) e.init[i] * u;
+        état_écrit(i0 + i, si0);
+        y += (Tc) e.C[i] * si0;
+      }
+      u = y;
+      i0 += e.N;
+    }
+    premier_appel = non;
+  }
+
+  T step_éch(T x)
+  {
+    si(premier_appel)
+      init(x);
+    T y = D * x;
+    pour(auto i = 0; i < N; i++)
+    {
+      y += C(i) * état(i);
+      T w = B(i) * x;
+      pour(auto j = 0; j < N; j++)
+        w += A(i * N + j) * état(j);
+      s2(i) = w;
+    }
+    pour(auto i = 0; i < N; i++)
+      état_écrit(i, s2(i));
+    retourne y;
+  }
+
+  // Un bloc de L échantillons (entrée déjà dans v[p][N...N+L-1], état dans v[p][0...N-1])
+  void bloc()
+  {
+    soit nv = N + L;
+    soit mv = [&](const Vecf *Mx, entier m, entier pc, entier pv, float *dst, bouléen accumule)
+    {
+      rii_mv(niveau, Mx[pc].data(), m, v[pv].data(), nv, dst, accumule);
+    };
+    si constexpr(coefs_complexes)
+    {
+      // (Mr + j Mi) (vr + j vi)
+      mv(M,  L, 0, 0, yb[0].data(), non);
+      mv(M,  L, 2, 1, yb[0].data(), oui);
+      mv(M,  L, 0, 1, yb[1].data(), non);
+      mv(M,  L, 1, 0, yb[1].data(), oui);
+      mv(M2, N, 0, 0, st[0].data(), non);
+      mv(M2, N, 2, 1, st[0].data(), oui);
+      mv(M2, N, 0, 1, st[1].data(), non);
+      mv(M2, N, 1, 0, st[1].data(), oui);
+    }
+    sinon
+    {
+      pour(auto p = 0; p < nb_plans; p++)
+      {
+        mv(M,  L, 0, p, yb[p].data(), non);
+        mv(M2, N, 0, p, st[p].data(), non);
+      }
+    }
+    pour(auto p = 0; p < nb_plans; p++)
+      memcpy(v[p].data(), st[p].data(), N * sizeof(float));
+  }
+
+  void step(const Vecteur<T> &x, Vecteur<T> &y)
+  {
+    soit n = x.rows();
+    si(n == 0)
+      retourne;
+    si(x.data() != y.data())
+      y.resize(n);
+    si(premier_appel)
+      init(x(0));
+
+    soit xp = x.data();
+    soit yp = y.data();
+    entier i0 = 0;
+    pour(; i0 + L <= n; i0 += L)
+    {
+      // (copie : traitement en place possible)
+      soit v0 = v[0].data() + N, v1 = v[nb_plans - 1].data() + N;
+      pour(auto i = 0; i < L; i++)
+      {
+        si constexpr(nb_plans == 2)
+        {
+          v0[i] = xp[i0 + i].real();
+          v1[i] = xp[i0 + i].imag();
+        }
+        sinon
+          v0[i] = xp[i0 + i];
+      }
+      bloc();
+      soit y0 = yb[0].data(), y1 = yb[nb_plans - 1].data();
+      pour(auto i = 0; i < L; i++)
+      {
+        si constexpr(nb_plans == 2)
+          yp[i0 + i] = T(y0[i], y1[i]);
+        sinon
+          yp[i0 + i] = y0[i];
+      }
+    }
+    pour(; i0 < n; i0++)
+      yp[i0] = step_éch(xp[i0]);
+  }
+};
+
+// Représentation d'état d'une chaine de sections du second ordre (mêmes coefficients, même structure,
+// et même initialisation que ChaineSOIS)
+static vector<RIIEtats<double>> sois_états(const FRat<cfloat> &h, RIIStructure structure)
+{
+  ChaineSOIS<float, float, float> chaine(h, structure);
+  vector<RIIEtats<double>> res;
+  pour(auto &sec: chaine.sections)
+  {
+    double b0 = sec.b0, b1 = sec.b1, b2 = sec.b2, a1 = sec.a1, a2 = sec.a2;
+    si(structure == RIIStructure::FormeDirecte2)
+    {
+      // s = (d[n-1], d[n-2]), d = x - a1 d[n-1] - a2 d[n-2], y = b0 d + b1 d[n-1] + b2 d[n-2]
+      RIIEtats<double> e(2, b0);
+      e.a(0, 0) = -a1;
+      e.a(0, 1) = -a2;
+      e.a(1, 0) = 1;
+      e.B[0] = 1;
+      e.C[0] = b1 - b0 * a1;
+      e.C[1] = b2 - b0 * a2;
+      e.init = {1.0, 1.0};
+      e.différence(0);
+      res.push_back(e);
+    }
+    sinon si(structure == RIIStructure::FormeDirecte1)
+    {
+      // s = (x[n-1], x[n-2], y[n-1], y[n-2])
+      RIIEtats<double> e(4, b0);
+      e.C = {b1, b2, -a1, -a2};
+      e.B[0] = 1;
+      e.a(1, 0) = 1;
+      pour(auto j = 0; j < 4; j++)
+        e.a(2, j) = e.C[j];
+      e.B[2] = b0;
+      e.a(3, 2) = 1;
+      e.init = {1.0, 1.0, 1.0, 1.0};
+      e.différence(0);
+      e.différence(2);
+      res.push_back(e);
+    }
+    sinon
+      échec("filtre_sois_bloc : structure non implémentée.");
+  }
+  si(chaine.avec_rii1)
+  {
+    // s = (y[n-1], x[n-1])
+    soit &r = chaine.rii1;
+    RIIEtats<double> e(2, r.b0);
+    e.a(0, 0) = -r.a1;
+    e.a(0, 1) = r.b1;
+    e.B = {r.b0, 1.0};
+    e.C = {-r.a1, r.b1};
+    res.push_back(e);
+  }
+  sinon
+    res.push_back(RIIEtats<double>(0, chaine.gain));
+  retourne res;
+}
+
+template<typename T>
+sptr<FiltreGen<T>> filtre_sois_bloc(const FRat<cfloat> &h, RIIStructure structure, entier dim_bloc)
+{
+  retourne make_shared<FiltreRIIBloc<T, float>>(sois_états(h, structure), dim_bloc);
+}
+
+template<typename T>
+sptr<FiltreGen<T>> filtre_sois_bloc(const FRat<float> &h, RIIStructure structure, entier dim_bloc)
+{
+  retourne filtre_sois_bloc<T>(sois_frat_complexe(h), structure, dim_bloc);
+}
+
+template<typename Tc, typename T>
+sptr<FiltreGen<T>> filtre_rii_bloc(const FRat<Tc> &h, entier dim_bloc)
+{
+  using Td = typename FiltreRIIBloc<T, Tc>::Td;
+
+  // Mêmes coefficients que FiltreRII (forme directe I, état initial nul)
+  soit h2  = h.eval_inv_z();
+  soit num = h2.numer.vers_coefs().coefs;
+  soit den = h2.denom.vers_coefs().coefs;
+  soit nx = num.rows() - 1, ny = den.rows() - 1;
+  Td a0 = (Td) den(0);
+
+  // s = (x[n-1], ..., x[n-nx], y[n-1], ..., y[n-ny])
+  RIIEtats<Td> e(nx + ny, (Td) num(0) / a0);
+  pour(auto k = 0; k < nx; k++)
+    e.C[k] = (Td) num(k + 1) / a0;
+  pour(auto k = 0; k < ny; k++)
+    e.C[nx + k] = - (Td) den(k + 1) / a0;
+  si(nx > 0)
+    e.B[0] = 1;
+  pour(auto k = 1; k < nx; k++)
+    e.a(k, k - 1) = 1;
+  si(ny > 0)
+  {
+    pour(auto j = 0; j < nx + ny; j++)
+      e.a(nx, j) = e.C[j];
+    e.B[nx] = e.D;
+  }
+  pour(auto k = 1; k < ny; k++)
+    e.a(nx + k, nx + k - 1) = 1;
+
+  retourne make_shared<FiltreRIIBloc<T, Tc>>(vector<RIIEtats<Td>>{e}, dim_bloc);
+}
+
+/////////////////////////////////////////////////////////////////////////
+// Filtrage zéro-phase par blocs parallèles
+/////////////////////////////////////////////////////////////////////////
+
+// f(0), ..., f(n-1) sur nb_threads threads (chaque thread prend le prochain indice libre)
+static void exécution_parallèle(entier n, entier nb_threads, const std::function<void (entier)> &f)
+{
+  nb_threads = min(nb_threads, n);
+  si(nb_threads <= 1)
+  {
+    pour(auto i = 0; i < n; i++)
+      f(i);
+    retourne;
+  }
+  std::atomic<entier> suivant{0};
+  std::exception_ptr erreur;
+  std::mutex mutex_erreur;
+  vector<std::thread> threads;
+  pour(auto t = 0; t < nb_threads; t++)
+  {
+    threads.emplace_back([&]()
+    {
+      pour(entier i = suivant++; i < n; i = suivant++)
+      {
+        try
+        {
+          f(i);
+        }
+        catch(...)
+        {
+          std::lock_guard<std::mutex> lock(mutex_erreur);
+          si(!erreur)
+            erreur = std::current_exception();
+        }
+      }
+    });
+  }
+  pour(auto &t: threads)
+    t.join();
+  si(erreur)
+    std::rethrow_exception(erreur);
+}
+
+/** Filtrage aller - retour par blocs indépendants : chaque bloc [s, e[ est filtré avec une marge
+ *  de W échantillons de part et d'autre (le temps que le régime transitoire disparaisse),
+ *  avec un nouveau filtre dans chaque sens. Les marges sont copiées avant tout traitement,
+ *  si bien que la sortie peut être la même zone mémoire que l'entrée. */
+template<typename T>
+static void filtfilt_blocs(std::span<const T> x, std::span<T> y, entier W, entier nb_threads,
+                           const std::function<sptr<FiltreGen<T>> ()> &création)
+{
+  entier n = x.size();
+  assertion_msg((entier) y.size() >= n,
+      "filtfilt : sortie trop petite ({} éléments, {} nécessaires).", y.size(), n);
+  si(n == 0)
+    retourne;
+  si(nb_threads <= 0)
+    nb_threads = max(1u, std::thread::hardware_concurrency());
+
+  // Marges négligeables devant les blocs, et au plus 2^20 échantillons par bloc (mémoire de travail)
+  soit C = max(8 * W, min((entier) 1 << 20, (n + nb_threads - 1) / nb_threads));
+  soit nb = (n + C - 1) / C;
+
+  vector<vector<T>> marge_g(nb), marge_d(nb);
+  pour(auto c = 0; c < nb; c++)
+  {
+    soit s = c * C, e = min(n, s + C);
+    marge_g[c].assign(x.data() + max((entier) 0, s - W), x.data() + s);
+    marge_d[c].assign(x.data() + e, x.data() + min(n, e + W));
+  }
+
+  exécution_parallèle(nb, nb_threads, [&](entier c)
+  {
+    soit s = c * C, e = min(n, s + C);
+    entier ng = marge_g[c].size(), nd = marge_d[c].size();
+    Vecteur<T> u(ng + (e - s) + nd);
+    soit up = u.data();
+    std::copy(marge_g[c].begin(), marge_g[c].end(), up);
+    std::copy(x.data() + s, x.data() + e, up + ng);
+    std::copy(marge_d[c].begin(), marge_d[c].end(), up + ng + (e - s));
+
+    soit m = u.rows();
+    création()->step(u, u);
+    std::reverse(up, up + m);
+    création()->step(u, u);
+    std::reverse(up, up + m);
+
+    std::copy(up + ng, up + ng + (e - s), y.data() + s);
+  });
+}
+
+// Durée du régime transitoire (en échantillons) : n tel que |A^n| < ε (pour toutes les composantes)
+static entier rii_durée_transitoire(const vector<RIIEtats<double>> &étages, double ε = 1e-8)
+{
+  RIIEtats<double> e;
+  pour(auto &étage: étages)
+    e.cascade(étage);
+  soit N = e.N;
+  si(N == 0)
+    retourne 0;
+  vector<double> P(N * N, 0.0), P2(N * N);
+  pour(auto i = 0; i < N; i++)
+    P[i * N + i] = 1;
+  pour(entier k = 1; k < (1 << 24); k++)
+  {
+    double mx = 0;
+    pour(auto i = 0; i < N; i++)
+    {
+      pour(auto j = 0; j < N; j++)
+      {
+        double s = 0;
+        pour(auto l = 0; l < N; l++)
+          s += e.A[i * N + l] * P[l * N + j];
+        P2[i * N + j] = s;
+        mx = max(mx, abs(s));
+      }
+    }
+    std::swap(P, P2);
+    si(mx < ε)
+      retourne k;
+  }
+  échec("filtfilt : filtre instable ou régime transitoire trop long.");
+  retourne 0;
+}
+
+template<typename T>
+void filtfilt_rif(const Vecf &h, std::span<const T> x, std::span<T> y, entier nb_threads)
+{
+  // RIF : marges de K - 1 échantillons, résultat exact (état initial nul dans les deux sens)
+  filtfilt_blocs<T>(x, y, max((entier) 0, h.rows() - 1), nb_threads,
+      [&](){retourne filtre_rif<float, T>(h);});
+}
+
+template<typename T>
+Vecteur<T> filtfilt_rif(const Vecf &h, const Vecteur<T> &x, entier nb_threads)
+{
+  Vecteur<T> y(x.rows());
+  filtfilt_rif<T>(h, std::span<const T>(x.data(), x.rows()), std::span<T>(y.data(), y.rows()), nb_threads);
+  retourne y;
+}
+
+template<typename T>
+void filtfilt(const FRat<float> &h, std::span<const T> x, std::span<T> y, entier nb_threads)
+{
+  si(h.est_rif())
+  {
+    Vecf c = h.numer.coefs.reverse();
+    retourne filtfilt_rif<T>(c, x, y, nb_threads);
+  }
+  filtfilt<T>(sois_frat_complexe(h), x, y, nb_threads);
+}
+
+template<typename T>
+void filtfilt(const FRat<cfloat> &h, std::span<const T> x, std::span<T> y, entier nb_threads)
+{
+  // Même factorisation que filtre_sois() (même initialisation, avec le premier échantillon),
+  // implémentation par bloc (filtre_sois_bloc()).
+  soit états = sois_états(h, FormeDirecte2);
+  filtfilt_blocs<T>(x, y, rii_durée_transitoire(états), nb_threads,
+      [&](){retourne make_shared<FiltreRIIBloc<T, float>>(états, 0);});
+}
+
+template<typename T, typename Tc>
+Vecteur<T> filtfilt(const FRat<Tc> &h, const Vecteur<T> &x, entier nb_threads)
+{
+  Vecteur<T> y(x.rows());
+  filtfilt<T>(h, std::span<const T>(x.data(), x.rows()), std::span<T>(y.data(), y.rows()), nb_threads);
+  retourne y;
 }
 
 template<typename T = float>
@@ -620,11 +1786,16 @@ struct FiltreDC: FiltreGen<T>
       y.resize(n);
 
     pour(auto i = 0; i < n; i++)
-    {
-      y(i) = (T) (α * ((x(i) - xp) + yp));
-      xp = x(i);
-      yp = y(i);
-    }
+      y(i) = FiltreDC::step_éch(x(i));
+  }
+
+  STEP_SPAN_PAR_ECH(FiltreDC)
+
+  T step_éch(T x)
+  {
+    yp = (T) (α * ((x - xp) + yp));
+    xp = x;
+    retourne yp;
   }
 };
 
@@ -656,13 +1827,18 @@ struct MoyenneGlissante: FiltreGen<T>
       y.resize(n);
 
     pour(auto i = 0; i < n; i++)
-    {
-      accu += x(i);
-      accu -= fenetre(index);
-      fenetre(index) = x(i);
-      index = (index + 1) % K;
-      y(i) = ((T) accu) * K_inv;
-    }
+      y(i) = MoyenneGlissante::step_éch(x(i));
+  }
+
+  STEP_SPAN_PAR_ECH(MoyenneGlissante)
+
+  T step_éch(T x)
+  {
+    accu += x;
+    accu -= fenetre(index);
+    fenetre(index) = x;
+    index = (index + 1) % K;
+    retourne ((T) accu) * K_inv;
   }
 };
 
@@ -760,6 +1936,20 @@ struct FiltreLExp : FiltreGen<T>
 
     init = oui;
   }
+
+  STEP_SPAN_PAR_ECH(FiltreLExp)
+
+  T step_éch(T x)
+  {
+    si(!init)
+    {
+      acc  = x;
+      init = oui;
+    }
+    Tacc xi = x;
+    acc += γ * (xi - acc);
+    retourne (T) acc;
+  }
 };
 
 
@@ -803,6 +1993,25 @@ template sptr<FiltreGen<float>> filtre_sois<float>(const FRat<cfloat> &coefs, RI
 template sptr<FiltreGen<float>> filtre_sois<float>(const FRat<float> &coefs, RIIStructure structure);
 template sptr<FiltreGen<cfloat>> filtre_sois<cfloat>(const FRat<cfloat> &coefs, RIIStructure structure);
 template sptr<FiltreGen<cfloat>> filtre_sois<cfloat>(const FRat<float> &coefs, RIIStructure structure);
+template sptr<FiltreGen<float>> filtre_sois_bloc<float>(const FRat<cfloat> &h, RIIStructure structure, entier dim_bloc);
+template sptr<FiltreGen<float>> filtre_sois_bloc<float>(const FRat<float> &h, RIIStructure structure, entier dim_bloc);
+template sptr<FiltreGen<cfloat>> filtre_sois_bloc<cfloat>(const FRat<cfloat> &h, RIIStructure structure, entier dim_bloc);
+template sptr<FiltreGen<cfloat>> filtre_sois_bloc<cfloat>(const FRat<float> &h, RIIStructure structure, entier dim_bloc);
+template sptr<FiltreGen<float>> filtre_rii_bloc(const FRat<float> &h, entier dim_bloc);
+template sptr<FiltreGen<cfloat>> filtre_rii_bloc(const FRat<cfloat> &h, entier dim_bloc);
+
+template void filtfilt<float>(const FRat<float> &h, std::span<const float> x, std::span<float> y, entier nb_threads);
+template void filtfilt<cfloat>(const FRat<float> &h, std::span<const cfloat> x, std::span<cfloat> y, entier nb_threads);
+template void filtfilt<float>(const FRat<cfloat> &h, std::span<const float> x, std::span<float> y, entier nb_threads);
+template void filtfilt<cfloat>(const FRat<cfloat> &h, std::span<const cfloat> x, std::span<cfloat> y, entier nb_threads);
+template Vecf filtfilt<float, float>(const FRat<float> &h, const Vecf &x, entier nb_threads);
+template Veccf filtfilt<cfloat, float>(const FRat<float> &h, const Veccf &x, entier nb_threads);
+template Vecf filtfilt<float, cfloat>(const FRat<cfloat> &h, const Vecf &x, entier nb_threads);
+template Veccf filtfilt<cfloat, cfloat>(const FRat<cfloat> &h, const Veccf &x, entier nb_threads);
+template void filtfilt_rif<float>(const Vecf &h, std::span<const float> x, std::span<float> y, entier nb_threads);
+template void filtfilt_rif<cfloat>(const Vecf &h, std::span<const cfloat> x, std::span<cfloat> y, entier nb_threads);
+template Vecf filtfilt_rif<float>(const Vecf &h, const Vecf &x, entier nb_threads);
+template Veccf filtfilt_rif<cfloat>(const Vecf &h, const Veccf &x, entier nb_threads);
 
 
 
@@ -64,9 +64,11 @@ Veccf hilbert_tfd(const Vecf &x)
 {
   // TODO : vérifier n pair et impair
   soit n = x.rows();
+  // (fft() et ifft() utilisent des plans persistants, propres à chaque thread)
   soit X = fft(x);
   X.tail(n/2).setZero();
-  retourne ifft(2 * X);
+  X *= 2;
+  retourne ifft(X);
 }
 
 }
@@ -0,0 +1,295 @@
+#include "tsd/tsd.hpp"
+#include "tsd/filtrage.hpp"
+#include "tsd/fourier.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+
+using namespace std;
+
+namespace tsd::filtrage
+{
+
+/////////////////////////////////////////////////////////////////////////
+// Profil de calibration (fichier local)
+/////////////////////////////////////////////////////////////////////////
+
+static std::mutex rif_profil_mutex;
+
+static string rif_profil_chemin()
+{
+  soit env = getenv("TSD_PROFIL_RIF");
+  si(env && *env)
+    retourne env;
+  soit home = getenv("HOME");
+  si(!home || !*home)
+    retourne "";
+  retourne string(home) + "/.tsd/profil-rif.txt";
+}
+
+// Format : une ligne "clé valeur" par paramètre
+static bouléen rif_profil_lecture(const string &chemin, RIFProfil &p)
+{
+  si(chemin.empty())
+    retourne non;
+  soit f = fopen(chemin.c_str(), "rt");
+  si(!f)
+    retourne non;
+  char clé[64];
+  float v;
+  entier nb = 0;
+  tantque(fscanf(f, "%63s %f", clé, &v) == 2)
+  {
+    soit c = string(clé);
+    si(c == "ns_coef_reel")
+      p.ns_coef_réel = v;
+    sinon si(c == "ns_coef_complexe")
+      p.ns_coef_complexe = v;
+    sinon si(c == "facteur_symetrique")
+      p.facteur_symétrique = v;
+    sinon si(c == "ns_flop_tfr")
+      p.ns_flop_tfr = v;
+    sinon si(c == "ns_flop_partition")
+      p.ns_flop_partition = v;
+    sinon
+      continue;
+    nb++;
+  }
+  fclose(f);
+  p.calibré = (nb == 5);
+  retourne p.calibré;
+}
+
+static void rif_profil_écriture(const string &chemin, const RIFProfil &p)
+{
+  si(chemin.empty())
+    retourne;
+  std::error_code ec;
+  soit dossier = std::filesystem::path(chemin).parent_path();
+  si(!dossier.empty())
+    std::filesystem::create_directories(dossier, ec);
+  soit f = fopen(chemin.c_str(), "wt");
+  si(!f)
+  {
+    msg_avert("RIF auto : impossible d'écrire le profil de calibration ({}).", chemin);
+    retourne;
+  }
+  fprintf(f, "ns_coef_reel %g\n",       p.ns_coef_réel);
+  fprintf(f, "ns_coef_complexe %g\n",   p.ns_coef_complexe);
+  fprintf(f, "facteur_symetrique %g\n", p.facteur_symétrique);
+  fprintf(f, "ns_flop_tfr %g\n",        p.ns_flop_tfr);
+  fprintf(f, "ns_flop_partition %g\n",  p.ns_flop_partition);
+  fclose(f);
+}
+
+static RIFProfil &rif_profil_courant()
+{
+  static RIFProfil profil = []
+  {
+    RIFProfil p;
+    rif_profil_lecture(rif_profil_chemin(), p);
+    retourne p;
+  }();
+  retourne profil;
+}
+
+RIFProfil rif_profil()
+{
+  std::lock_guard<std::mutex> lock(rif_profil_mutex);
+  retourne rif_profil_courant();
+}
+
+/////////////////////////////////////////////////////////////////////////
+// Micro-benchmark
+/////////////////////////////////////////////////////////////////////////
+
+// Meilleur temps (ns) sur plusieurs essais, après un premier appel
+template<typename T>
+static double rif_mesure(sptr<FiltreGen<T>> f, const Vecteur<T> &x, entier dim_bloc)
+{
+  Vecteur<T> y;
+  soit n = x.rows();
+  soit passe = [&]()
+  {
+    pour(auto i = 0; i + dim_bloc <= n; i += dim_bloc)
+      f->step(x.segment(i, dim_bloc), y);
+  };
+  passe();
+  double t = 1e30;
+  pour(auto essai = 0; essai < 20; essai++)
+  {
+    soit t0 = std::chrono::steady_clock::now();
+    passe();
+    soit t1 = std::chrono::steady_clock::now();
+    t = min(t, std::chrono::duration<double, std::nano>(t1 - t0).count());
+  }
+  retourne t;
+}
+
+// Complexité OLA (opérations par échantillon), même modèle que ola_complexité()
+static float rif_ola_complexité(entier N, entier Ne)
+{
+  retourne (1.0f / Ne) * 2 * 5 * N * log2((float) N);
+}
+
+// Complexité de la convolution partitionnée (opérations par échantillon) :
+// TFR directe et inverse de dimension 2B, et P produits fréquentiels, pour chaque bloc de B échantillons
+// (pour des données réelles, TFR réelles et demi-spectres).
+static float rif_partition_complexité(entier K, entier B, bouléen complexe)
+{
+  soit N = 2 * B, P = (K + B - 1) / B;
+  soit nb_bins = complexe ? N : N / 2 + 1;
+  soit tfr = 2 * 5 * N * log2((float) N);
+  si(!complexe)
+    tfr /= 2;
+  retourne (tfr + 8.0f * P * nb_bins) / B;
+}
+
+RIFProfil rif_calibration(bouléen sauve)
+{
+  RIFProfil p;
+  soit n = 16 * 1024;
+
+  // Implémentation directe (coefficients quelconques, puis symétriques)
+  {
+    soit K = 64;
+    Vecf h = design_rif_fen(K - 1, "lp", 0.2) | Vecf::valeurs({0.01f});
+    Vecf x = randn(n);
+    Veccf xc = randn(n) + ⅈ * randn(n);
+    p.ns_coef_réel     = rif_mesure(filtre_rif<float, float>(h),  x,  n) / (n * K);
+    p.ns_coef_complexe = rif_mesure(filtre_rif<float, cfloat>(h), xc, n) / (n * K);
+
+    soit hs = design_rif_fen(K - 1, "lp", 0.2);
+    soit ts = rif_mesure(filtre_rif<float, cfloat>(hs), xc, n) / (n * (K - 1));
+    // (le repliement ne peut pas être plus coûteux : écart dû au bruit de mesure)
+    p.facteur_symétrique = min(1.0, ts / p.ns_coef_complexe);
+  }
+
+  // OLA
+  {
+    soit K = 256, N = 1024, Ne = N - K;
+    soit h = design_rif_fen(K, "lp", 0.2);
+    soit m = (n / Ne) * Ne;
+    Veccf x = randn(m) + ⅈ * randn(m);
+    soit t = rif_mesure(filtre_rif_fft<cfloat>(h, Ne), x, Ne);
+    p.ns_flop_tfr = t / (m * rif_ola_complexité(N, Ne));
+  }
+
+  // Convolution partitionnée
+  {
+    soit K = 1024, B = 64;
+    soit h = design_rif_fen(K, "lp", 0.2);
+    Veccf x = randn(n) + ⅈ * randn(n);
+    soit t = rif_mesure(filtre_rif_partition<cfloat>(h, B), x, B);
+    p.ns_flop_partition = t / (n * rif_partition_complexité(K, B, oui));
+  }
+
+  p.calibré = oui;
+  msg("RIF auto : calibration : direct = {:.4f} ns (réel), {:.4f} ns (complexe) / coef / éch, "
+      "facteur symétrique = {:.2f}, OLA = {:.4f} ns / op, partitions = {:.4f} ns / op.",
+      p.ns_coef_réel, p.ns_coef_complexe, p.facteur_symétrique, p.ns_flop_tfr, p.ns_flop_partition);
+
+  {
+    std::lock_guard<std::mutex> lock(rif_profil_mutex);
+    rif_profil_courant() = p;
+    si(sauve)
+      rif_profil_écriture(rif_profil_chemin(), p);
+  }
+  retourne p;
+}
+
+/////////////////////////////////////////////////////////////////////////
+// Choix de l'implémentation
+/////////////////////////////////////////////////////////////////////////
+
+RIFImplémentation rif_choix_implémentation(entier K, entier dim_bloc_typique, entier latence_max,
+                                           bouléen complexe, bouléen symétrique,
+                                           const RIFProfil &profil)
+{
+  RIFImplémentation res;
+  res.type = RIFImplémentation::DIRECTE;
+  res.coût = K * (complexe ? profil.ns_coef_complexe : profil.ns_coef_réel);
+  si(symétrique)
+    res.coût *= profil.facteur_symétrique;
+
+  // OLA, blocs de Ne échantillons : TFR de dimension N = 2^k >= Ne + K,
+  // et recouvrement N - Ne <= Ne.
+  soit essai = [&](entier Ne)
+  {
+    si((Ne <= 0) || ((latence_max >= 0) && (Ne > latence_max)))
+      retourne;
+    soit N = prochaine_puissance_de_2(Ne + K);
+    si(N - Ne > Ne)
+      retourne;
+    soit coût = rif_ola_complexité(N, Ne) * profil.ns_flop_tfr;
+    si(coût < res.coût)
+    {
+      res.type      = RIFImplémentation::OLA;
+      res.dim_bloc  = Ne;
+      res.latence   = Ne;
+      res.retard    = Ne - K;
+      res.coût      = coût;
+    }
+  };
+
+  // Convolution partitionnée : latence d'une partition, pas de retard
+  soit essai_partition = [&](entier B)
+  {
+    si((B <= 0) || ((latence_max >= 0) && (B > latence_max)))
+      retourne;
+    soit coût = rif_partition_complexité(K, B, complexe) * profil.ns_flop_partition;
+    si(coût < res.coût)
+    {
+      res.type      = RIFImplémentation::PARTITIONNÉE;
+      res.dim_bloc  = B;
+      res.latence   = B;
+      res.retard    = 0;
+      res.coût      = coût;
+    }
+  };
+
+  // Blocs de même dimension que ceux de l'appelant (pas de ré-assemblage)
+  si(dim_bloc_typique > 0)
+  {
+    essai(dim_bloc_typique);
+    essai_partition(dim_bloc_typique);
+  }
+
+  // Sinon, blocs les plus grands possibles pour chaque dimension de TFR
+  soit N0 = prochaine_puissance_de_2(2 * K);
+  pour(auto N = N0; N <= (1 << 22); N *= 2)
+    essai(N - K);
+
+  // Partitions (puissances de 2, de 16 jusqu'à la dimension du filtre)
+  pour(auto B = 16; B <= max(K, (entier) 16); B *= 2)
+    essai_partition(B);
+
+  retourne res;
+}
+
+template<typename T>
+sptr<FiltreGen<T>> filtre_rif_auto(const Vecf &h, entier dim_bloc_typique, entier latence_max,
+                                   RIFImplémentation *choix)
+{
+  soit K = h.rows();
+  soit c = rif_choix_implémentation(K, dim_bloc_typique, latence_max, est_complexe<T>(),
+                                    (K >= 4) && (rif_symétrie(h) != 0));
+  si(choix)
+    *choix = c;
+  si(c.type == RIFImplémentation::OLA)
+    retourne filtre_rif_fft<T>(h, c.dim_bloc);
+  si(c.type == RIFImplémentation::PARTITIONNÉE)
+    retourne filtre_rif_partition<T>(h, c.dim_bloc);
+  retourne filtre_rif<float, T>(h);
+}
+
+template
+sptr<FiltreGen<float>> filtre_rif_auto<float>(const Vecf &h, entier dim_bloc_typique, entier latence_max,
+                                              RIFImplémentation *choix);
+
+template
+sptr<FiltreGen<cfloat>> filtre_rif_auto<cfloat>(const Vecf &h, entier dim_bloc_typique, entier latence_max,
+                                                RIFImplémentation *choix);
+
+}
@@ -0,0 +1,229 @@
+#include "tsd/tsd.hpp"
+#include "tsd/filtrage.hpp"
+#include <cstring>
+
+using namespace std;
+
+namespace tsd::filtrage
+{
+
+/** @brief Banc de filtres RIF identiques, appliqué à plusieurs canaux
+ *
+ *  Les lignes à retard des canaux sont entrelacées (une ligne de L flottants par instant),
+ *  si bien que la sortie j = t.L + c (instant t, voie c) s'écrit :
+ *  @f[
+ *  y_j = \sum_k h'_k \cdot a_{j + L.k}
+ *  @f]
+ *  avec h' les coefficients dans l'ordre inverse : c'est le noyau RIF par bloc (rif_bloc()) avec un pas de L.
+ *  Chaque coefficient chargé sert donc à plusieurs voies (et plusieurs instants), dans les registres SIMD.
+ *
+ *  Les canaux sont répartis en groupes indépendants (chaque groupe a sa propre ligne à retard),
+ *  assez étroits pour que la fenêtre de K lignes reste dans le cache L1,
+ *  et traités en parallèle si OpenMP est activé (LIBTSD_USE_OMP).
+ *
+ *  Coefficients réels : une voie par canal (données réelles), ou deux (parties réelles et imaginaires entrelacées).
+ *  Coefficients complexes : deux plans (parties réelles, parties imaginaires), et quatre produits réels.
+ *
+ *  Comme pour filtre_rif(), les coefficients symétriques ou anti-symétriques sont repliés
+ *  (pré-addition des échantillons partageant le même coefficient). */
+template<typename Tc, typename T>
+struct FiltreRIFMulti: FiltreMultiCanaux<T>
+{
+  static constexpr bouléen coefs_complexes = est_complexe<Tc>();
+  static constexpr entier nb_plans = coefs_complexes ? 2 : 1;
+
+  struct Groupe
+  {
+    // Canaux [c0, c0 + nc[
+    entier c0 = 0, nc = 0;
+    // Nombre de flottants par ligne (et par plan)
+    entier L = 0;
+    // Nombre de lignes traitées à la fois (de l'ordre de 32 ko par plan, pour rester dans le cache)
+    entier nt = 0;
+    // Lignes à retard entrelacées : K - 1 lignes d'historique, puis nt lignes
+    Vecf ligne[2];
+    // Sorties entrelacées (nt lignes)
+    Vecf sortie[2];
+  };
+
+  entier K = 0, nb_canaux = 0;
+  // Coefficients dans l'ordre inverse (réels, ou parties réelles / imaginaires / opposées des parties imaginaires),
+  // repliés si symétriques (Q coefficients)
+  Vecf hr, hi, hi_neg;
+  entier symétrie = 0, Q = 0;
+  vector<Groupe> groupes;
+
+  FiltreRIFMulti(const Vecteur<Tc> &h, entier nb_canaux, entier nb_groupes)
+  {
+    K = h.rows();
+    this->nb_canaux = nb_canaux;
+    si(K == 0)
+      échec("filtre_rif_multi : filtre vide.");
+    si(nb_canaux <= 0)
+      échec("filtre_rif_multi : nombre de canaux invalide ({}).", nb_canaux);
+
+    hr.resize(K);
+    si constexpr(coefs_complexes)
+    {
+      hi.resize(K);
+      hi_neg.resize(K);
+    }
+    pour(auto k = 0; k < K; k++)
+    {
+      si constexpr(coefs_complexes)
+      {
+        hr(k)     =  h(K - 1 - k).real();
+        hi(k)     =  h(K - 1 - k).imag();
+        hi_neg(k) = -h(K - 1 - k).imag();
+      }
+      sinon
+        hr(k) = h(K - 1 - k);
+    }
+
+    // Repliement (même critère que filtre_rif())
+    symétrie = (K >= 4) ? rif_symétrie(h) : 0;
+    Q = K;
+    si(symétrie != 0)
+    {
+      Q  = (K + 1) / 2;
+      hr = rif_coefs_repliés(hr, symétrie);
+      si constexpr(coefs_complexes)
+      {
+        hi     = rif_coefs_repliés(hi, symétrie);
+        hi_neg = rif_coefs_repliés(hi_neg, symétrie);
+      }
+    }
+
+    // Largeur des groupes : la fenêtre de K lignes parcourue par le noyau doit rester dans le cache L1
+    // (de l'ordre de 24 ko), au moins 16 flottants par ligne.
+    soit lpc  = (!coefs_complexes && est_complexe<T>()) ? 2 : 1;
+    soit Lmax = max((entier) 16, 6144 / Q);
+    soit dg   = max((entier) 1, Lmax / lpc);
+    nb_groupes = max((entier) 1, min(nb_groupes, nb_canaux));
+    dg = min(dg, (nb_canaux + nb_groupes - 1) / nb_groupes);
+    pour(auto c0 = 0; c0 < nb_canaux; c0 += dg)
+    {
+      Groupe g;
+      g.c0 = c0;
+      g.nc = min(dg, nb_canaux - c0);
+      // Coefficients réels et données complexes : parties réelles et imaginaires entrelacées
+      g.L  = (!coefs_complexes && est_complexe<T>()) ? 2 * g.nc : g.nc;
+      g.nt = max((entier) 16, 8192 / g.L);
+      pour(auto p = 0; p < nb_plans; p++)
+      {
+        g.ligne[p]  = Vecf::zeros((K - 1 + g.nt) * g.L);
+        g.sortie[p] = Vecf::zeros(g.nt * g.L);
+      }
+      groupes.push_back(g);
+    }
+  }
+
+  // Lignes [i0, i0 + n[ des canaux du groupe
+  void step_groupe(Groupe &g, const TabT<T,2> &x, TabT<T,2> &y, entier i0, entier n)
+  {
+    soit N = x.rows(), L = g.L;
+    soit h0 = (K - 1) * L;
+
+    // Entrelacement des canaux
+    float *l0 = g.ligne[0].data() + h0, *l1 = g.ligne[nb_plans - 1].data() + h0;
+    pour(auto c = 0; c < g.nc; c++)
+    {
+      const T *xc = x.data() + (g.c0 + c) * N + i0;
+      pour(auto i = 0; i < n; i++)
+      {
+        si constexpr(coefs_complexes)
+        {
+          l0[i * L + c] = xc[i].real();
+          l1[i * L + c] = xc[i].imag();
+        }
+        sinon si constexpr(est_complexe<T>())
+        {
+          l0[i * L + 2 * c]     = xc[i].real();
+          l0[i * L + 2 * c + 1] = xc[i].imag();
+        }
+        sinon
+          l0[i * L + c] = xc[i];
+      }
+    }
+
+    // Filtrage : n.L sorties, pas de L flottants entre deux coefficients
+    soit a0 = g.ligne[0].data(), a1 = g.ligne[nb_plans - 1].data();
+    soit s0 = g.sortie[0].data(), s1 = g.sortie[nb_plans - 1].data();
+    soit m = n * L;
+    soit filtre = [&](const Vecf &c, const float *a, float *dst, bouléen accumule)
+    {
+      si(symétrie == 0)
+        retourne rif_bloc(c.data(), K, a, dst, m, L, accumule);
+      si(!accumule)
+        memset(dst, 0, m * sizeof(float));
+      rif_bloc_replié(c.data(), Q, a, a + L * (K - 1), dst, m, L, symétrie == -1);
+    };
+    si constexpr(coefs_complexes)
+    {
+      // (hr + j hi) (xr + j xi)
+      filtre(hr,     a0, s0, non);
+      filtre(hi_neg, a1, s0, oui);
+      filtre(hr,     a1, s1, non);
+      filtre(hi,     a0, s1, oui);
+    }
+    sinon
+      filtre(hr, a0, s0, non);
+
+    // Désentrelacement
+    pour(auto c = 0; c < g.nc; c++)
+    {
+      T *yc = y.data() + (g.c0 + c) * N + i0;
+      pour(auto i = 0; i < n; i++)
+      {
+        si constexpr(coefs_complexes)
+          yc[i] = T(s0[i * L + c], s1[i * L + c]);
+        sinon si constexpr(est_complexe<T>())
+          yc[i] = T(s0[i * L + 2 * c], s0[i * L + 2 * c + 1]);
+        sinon
+          yc[i] = s0[i * L + c];
+      }
+    }
+
+    // Historique : K - 1 dernières lignes
+    pour(auto p = 0; p < nb_plans; p++)
+      memmove(g.ligne[p].data(), g.ligne[p].data() + n * L, h0 * sizeof(float));
+  }
+
+  void step(const TabT<T,2> &x, TabT<T,2> &y)
+  {
+    soit n = x.rows();
+    assertion_msg(x.cols() == nb_canaux,
+                  "filtre_rif_multi : nombre de canaux invalide ({}, attendu : {}).", x.cols(), nb_canaux);
+    y.resize(n, nb_canaux);
+    si(n == 0)
+      retourne;
+
+    soit ng = (entier) groupes.size();
+#   if LIBTSD_USE_OMP
+#   pragma omp parallel for
+#   endif
+    pour(auto i = 0; i < ng; i++)
+    {
+      soit &g = groupes[i];
+      pour(auto i0 = 0; i0 < n; i0 += g.nt)
+        step_groupe(g, x, y, i0, min(g.nt, n - i0));
+    }
+  }
+};
+
+template<typename Tc, typename T>
+sptr<FiltreMultiCanaux<T>> filtre_rif_multi(const Vecteur<Tc> &h, entier nb_canaux, entier nb_groupes)
+{
+  retourne make_shared<FiltreRIFMulti<Tc, T>>(h, nb_canaux, nb_groupes);
+}
+
+template
+sptr<FiltreMultiCanaux<float>> filtre_rif_multi<float, float>(const Vecf &h, entier nb_canaux, entier nb_groupes);
+
+template
+sptr<FiltreMultiCanaux<cfloat>> filtre_rif_multi<float, cfloat>(const Vecf &h, entier nb_canaux, entier nb_groupes);
+
+template
+sptr<FiltreMultiCanaux<cfloat>> filtre_rif_multi<cfloat, cfloat>(const Veccf &h, entier nb_canaux, entier nb_groupes);
+
+}
@@ -253,7 +253,8 @@ struct CQT::Impl
   entier abs_position = 0, nb_data_attendu = 0;
   Veci kposition, kaposition;
   Vecf cirbuffer;
-  sptr<FFTPlan> plan_fft;
+  sptr<FiltreGen<float, cfloat>> plan_rfft;
+  Veccf X;
 
   struct Sortie
   {
@@ -275,7 +276,7 @@ struct CQT::Impl
     kaposition  = Veci::zeros(cqtk.nfreqs);
     cirbuffer   = Vecf::zeros(cqtk.N);
 
-    plan_fft = tfrplan_création(cqtk.N, oui);
+    plan_rfft = rtfrplan_création(cqtk.N);
   }
 
   void step(const Vecf &x)
@@ -309,10 +310,7 @@ struct CQT::Impl
     cirbuffer.tail(nb_data_attendu) = x;
 
     // (2) Change to frequency domain
-    //ArrayXcf X = fft(cirbuffer);
-
-    // TODO : utiliser plan rfft
-    soit X = plan_fft->step(cirbuffer);
+    plan_rfft->step(cirbuffer, X);
 
     soit minimal_position = N;
     // (3) Kernels correlations
@@ -244,7 +244,10 @@ struct DetecteurImpl: Detecteur
       si(abs(corr(i)) <= sqrt(seuil))
         corr(i) = 0;
 
-    y = ratio * sqrt(abs2(corr) / (en + 1e-20f));
+    // Evaluation en une seule passe (pas de tableau intermédiaire)
+    y = abs2(paresseux(corr)) / (paresseux(en) + 1e-20f);
+    y = sqrt(y);
+    y *= ratio;
 
 
     // TODO: Pb à régler plus proprement (premier buffer nul)
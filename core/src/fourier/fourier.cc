@@ -4,6 +4,13 @@
 
 #include <bit>
 #include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# include <immintrin.h>
+#endif
 
 
 using namespace std;
@@ -58,19 +65,221 @@ auto itfr_rotation(entier n)
 }
 
 
-/** @brief Calcul TFR Cooley–Tukey (N doit être une puissance de 2) */
+/** @brief Facteurs de rotation de chaque étage de la TFR radix 2, rangés de manière contiguë.
+ *
+ *  L'étage comportant n groupes de papillons (n = 1, 2, 4, ..., N/2)
+ *  utilise les n valeurs @f$W_{2n}^k@f$, stockées à partir de l'index n - 1
+ *  (soit N - 1 valeurs au total, lues séquentiellement). */
+template<typename T>
+Vecteur<complex<T>> tfr_rotations_etages(const Vecteur<complex<T>> &rotations)
+{
+  soit N = rotations.rows();
+  Vecteur<complex<T>> res(max(N - 1, 1));
+  pour(entier n = 1; n < N; n *= 2)
+  {
+    soit pas = N / (2 * n);
+    pour(entier k = 0; k < n; k++)
+      res(n - 1 + k) = rotations(k * pas);
+  }
+  retourne res;
+}
+
+/** @brief Un étage de la TFR radix 2 (version scalaire)
+ *
+ *  E   : entrée de l'étage (N points),
+ *  X   : sortie de l'étage (N points),
+ *  rot : facteurs de rotation de l'étage (n valeurs). */
+template<typename T, typename Trotation, bouléen avant>
+void tfr_radix2_etage(const complex<T> *E, complex<T> *X, const complex<Trotation> *rot,
+                      entier N, entier n, entier pas)
+{
+  soit Xp  = X,
+       Xp2 = X + N / 2;
+
+  pour(entier k = 0; k < n; k++)
+  {
+    soit r = rot[k];
+
+    si constexpr(!avant)
+      r = conj(r);
+
+    const soit tr = r.real(), ti = r.imag();
+    pour(entier m = 0; m < pas; m++)
+    {
+      const soit g = *(E + pas), e = *E;
+      const soit gx = g.real(), gy = g.imag();
+      const complex<T> p(tr * gx - ti * gy, tr * gy + ti * gx);
+      *Xp++  = e + p;
+      *Xp2++ = e - p;
+      E++;
+    }
+    E += pas;
+  }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define TSD_TFR_SIMD 1
+#else
+# define TSD_TFR_SIMD 0
+#endif
+
+#if TSD_TFR_SIMD
+
+// Versions vectorisées : chaque registre contient 2 (SSE2), 4 (AVX2) ou 8 (AVX-512) complexes
+// consécutifs, qui partagent le même facteur de rotation tant que pas est suffisant.
+// Sinon (derniers étages), on se rabat sur la version plus étroite.
+
+template<bouléen avant>
+static void tfr_radix2_etage_sse2(const cfloat *E, cfloat *X, const cfloat *rot, entier N, entier n, entier pas)
+{
+  si(pas < 2)
+  {
+    tfr_radix2_etage<float, float, avant>(E, X, rot, N, n, pas);
+    retourne;
+  }
+  soit Xp  = (float *) X,
+       Xp2 = (float *) (X + N / 2);
+  soit e0  = (const float *) E;
+  pour(entier k = 0; k < n; k++)
+  {
+    soit tr = rot[k].real(), ti = avant ? rot[k].imag() : -rot[k].imag();
+    soit vtr = _mm_set1_ps(tr),
+         vti = _mm_setr_ps(-ti, ti, -ti, ti);
+    pour(entier m = 0; m < pas; m += 2)
+    {
+      soit e  = _mm_loadu_ps(e0 + 2 * m),
+           g  = _mm_loadu_ps(e0 + 2 * (m + pas)),
+           gs = _mm_shuffle_ps(g, g, _MM_SHUFFLE(2, 3, 0, 1)),
+           p  = _mm_add_ps(_mm_mul_ps(g, vtr), _mm_mul_ps(gs, vti));
+      _mm_storeu_ps(Xp,  _mm_add_ps(e, p));
+      _mm_storeu_ps(Xp2, _mm_sub_ps(e, p));
+      Xp  += 4;
+      Xp2 += 4;
+    }
+    e0 += 4 * pas;
+  }
+}
+
+template<bouléen avant>
+__attribute__((target("avx2,fma")))
+static void tfr_radix2_etage_avx2(const cfloat *E, cfloat *X, const cfloat *rot, entier N, entier n, entier pas)
+{
+  si(pas < 4)
+  {
+    tfr_radix2_etage_sse2<avant>(E, X, rot, N, n, pas);
+    retourne;
+  }
+  soit Xp  = (float *) X,
+       Xp2 = (float *) (X + N / 2);
+  soit e0  = (const float *) E;
+  pour(entier k = 0; k < n; k++)
+  {
+    soit vtr = _mm256_set1_ps(rot[k].real()),
+         vti = _mm256_set1_ps(avant ? rot[k].imag() : -rot[k].imag());
+    pour(entier m = 0; m < pas; m += 4)
+    {
+      soit e  = _mm256_loadu_ps(e0 + 2 * m),
+           g  = _mm256_loadu_ps(e0 + 2 * (m + pas)),
+           gs = _mm256_permute_ps(g, 0xB1),
+           p  = _mm256_fmaddsub_ps(g, vtr, _mm256_mul_ps(gs, vti));
+      _mm256_storeu_ps(Xp,  _mm256_add_ps(e, p));
+      _mm256_storeu_ps(Xp2, _mm256_sub_ps(e, p));
+      Xp  += 8;
+      Xp2 += 8;
+    }
+    e0 += 4 * pas;
+  }
+}
+
+template<bouléen avant>
+__attribute__((target("avx512f")))
+static void tfr_radix2_etage_avx512(const cfloat *E, cfloat *X, const cfloat *rot, entier N, entier n, entier pas)
+{
+  si(pas < 8)
+  {
+    tfr_radix2_etage_avx2<avant>(E, X, rot, N, n, pas);
+    retourne;
+  }
+  soit Xp  = (float *) X,
+       Xp2 = (float *) (X + N / 2);
+  soit e0  = (const float *) E;
+  pour(entier k = 0; k < n; k++)
+  {
+    soit vtr = _mm512_set1_ps(rot[k].real()),
+         vti = _mm512_set1_ps(avant ? rot[k].imag() : -rot[k].imag());
+    pour(entier m = 0; m < pas; m += 8)
+    {
+      soit e  = _mm512_loadu_ps(e0 + 2 * m),
+           g  = _mm512_loadu_ps(e0 + 2 * (m + pas)),
+           gs = _mm512_permute_ps(g, 0xB1),
+           p  = _mm512_fmaddsub_ps(g, vtr, _mm512_mul_ps(gs, vti));
+      _mm512_storeu_ps(Xp,  _mm512_add_ps(e, p));
+      _mm512_storeu_ps(Xp2, _mm512_sub_ps(e, p));
+      Xp  += 16;
+      Xp2 += 16;
+    }
+    e0 += 4 * pas;
+  }
+}
+
+/** Jeu d'instructions le plus large supporté par le processeur (détecté une seule fois) */
+static entier tfr_simd_détection()
+{
+  __builtin_cpu_init();
+  si(__builtin_cpu_supports("avx512f"))
+    retourne 3;
+  si(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    retourne 2;
+  retourne 1;
+}
+
+static const entier tfr_simd_cpu = tfr_simd_détection();
+
+#endif
+
+entier tfr_simd_max = 3;
+
+entier tfr_simd_niveau()
+{
+# if TSD_TFR_SIMD
+  retourne min(tfr_simd_cpu, tfr_simd_max);
+# else
+  retourne 0;
+# endif
+}
+
+template<bouléen avant>
+static void tfr_radix2_etage_float(const cfloat *E, cfloat *X, const cfloat *rot,
+                                   entier N, entier n, entier pas, entier niveau)
+{
+# if TSD_TFR_SIMD
+  switch(niveau)
+  {
+  case 3:  tfr_radix2_etage_avx512<avant>(E, X, rot, N, n, pas); retourne;
+  case 2:  tfr_radix2_etage_avx2<avant>(E, X, rot, N, n, pas);   retourne;
+  case 1:  tfr_radix2_etage_sse2<avant>(E, X, rot, N, n, pas);   retourne;
+  default: break;
+  }
+# endif
+  tfr_radix2_etage<float, float, avant>(E, X, rot, N, n, pas);
+}
+
+
+/** @brief Calcul TFR Cooley–Tukey (N doit être une puissance de 2)
+ *
+ *  rot_etages : facteurs de rotation rangés par étage (voir @ref tfr_rotations_etages()). */
 template<typename T, typename Trotation, bouléen avant>
 void tfr_radix2(Vecteur<complex<T>> &X,
                 const Vecteur<complex<T>> &x,
                 Vecteur<complex<T>> &scratch,
-                const Vecteur<complex<Trotation>> &rotations)
+                const Vecteur<complex<Trotation>> &rot_etages)
 {
   soit N               = x.rows();
   soit iteration_paire = ((N & 0x55555555) != 0);
 
   scratch.resize(N);
   X.resize(N);
-  assertion_safe(rotations.rows() == N, "La matrice de twiddles n'est pas initialisée.");
+  assertion_safe(rot_etages.rows() >= N - 1, "La matrice de twiddles n'est pas initialisée.");
 
   si(N == 1)
   {
@@ -78,8 +287,10 @@ void tfr_radix2(Vecteur<complex<T>> &X,
     retourne;
   }
 
-  soit E = x.data();
-  complex<T> *Xp, *Xp2, *Xstart;
+  const complex<T> *E = x.data();
+  complex<T> *Xstart;
+
+  soit niveau = tfr_simd_niveau();
 
   // Commence par calculer les TFR de plus bas niveau
   // puis remonte petit à petit
@@ -90,28 +301,13 @@ void tfr_radix2(Vecteur<complex<T>> &X,
     // ....
     Xstart = iteration_paire ? scratch.data() : X.data();
     soit pas = N / (2 * n);
-    Xp  = Xstart;
-    Xp2 = Xstart + N / 2;
-
-    pour(entier k = 0; k < n; k++)
-    {
-      soit rot = rotations(k * pas);
+    soit rot = rot_etages.data() + (n - 1);
 
-      si constexpr(!avant)
-          rot = conj(rot);
+    si constexpr(std::is_same_v<T, float> && std::is_same_v<Trotation, float>)
+      tfr_radix2_etage_float<avant>(E, Xstart, rot, N, n, pas, niveau);
+    sinon
+      tfr_radix2_etage<T, Trotation, avant>(E, Xstart, rot, N, n, pas);
 
-      const soit tr = rot.real(), ti = rot.imag();
-      pour(entier m = 0; m < pas; m++)
-      {
-        const soit g = *(E + pas), e = *E;
-        const soit gx = g.real(), gy = g.imag();
-        const complex<T> p(tr * gx - ti * gy, tr * gy + ti * gx);
-        *Xp++  = e + p;
-        *Xp2++ = e - p;
-        E++;
-      }
-      E += pas;
-    }
     E = Xstart;
     iteration_paire = !iteration_paire;
   }
@@ -232,7 +428,7 @@ Vecteur<T> irtfr_calcule(const Vecteur<complex<T>> &X) // Size n/2
 
 
 
-// twidlles  : n2
+// twidlles  : n2 - 1 (rangés par étage)
 // chirp     : 2*n-1
 Veccf tfr_czt_impl(const Veccf &x, entier n2, const Veccf &twiddles, const Veccf &chirp)
 {
@@ -277,14 +473,20 @@ Veccf tfr2itfr(const Veccf &X)
   retourne Y;
 }
 
+/** @brief Plan de TFR réelle.
+ *
+ *  Si n est pair, les n échantillons réels sont vus comme n/2 échantillons complexes
+ *  (recopie directe, les parties réelles et imaginaires étant entrelacées en mémoire),
+ *  et une seule TFR de dimension n/2 est calculée.
+ *  Tous les tampons sont alloués à la configuration. */
 template<typename T>
 struct RTFRPlan: FiltreGen<T, complex<T>>
 {
   using cT = complex<T>;
 
-  entier n;
+  entier n = -1;
   sptr<FFTPlan> cplan;
-  Veccf rotations;
+  Vecteur<cT> rotations, x2, Xt;
 
   RTFRPlan(entier n)
   {
@@ -300,11 +502,14 @@ struct RTFRPlan: FiltreGen<T, complex<T>>
       {
         cplan      = tfrplan_création(n/2);
         rotations  = tfr_rotation<T>(n);
+        x2.resize(n/2);
+        Xt.resize(n/2);
       }
       sinon
       {
-        // si n est impair, on fait juste bêtement une FFT.
+        // n impair : TFR complexe de dimension n
         cplan = tfrplan_création(n);
+        x2.resize(n);
       }
     }
   }
@@ -312,56 +517,660 @@ struct RTFRPlan: FiltreGen<T, complex<T>>
   {
     si(x.rows() != n)
       configure(x.rows());
+    y.resize(n);
+    si((n & 1) == 0)
+    {
+      // x(2i) + j x(2i+1)
+      memcpy((void *) x2.data(), x.data(), n * sizeof(T));
+
+      // Compute n/2 FFT points in Xt
+      cplan->step(x2, Xt, oui);
+
+      const cT j2(0, 0.5 / sqrt(2)), r2(0.5 / sqrt(2), 0);
+
+      // (accès directs aux données : pas de vérification d'index ni de temporaire,
+      //  ce qui compte pour les petites dimensions)
+      soit h = n / 2;
+      const cT *xt = Xt.data(), *rt = rotations.data();
+      cT *Y = y.data();
+
+      pour(auto i = 0; i <= h; i++)
+      {
+        soit X1 = xt[(i == h) ? 0 : i],
+             X2 = conj(xt[(i > 0) ? h - i : 0]);
+        Y[i] = r2 * (X1 + X2) - j2 * (X1 - X2) * rt[i];
+      }
+
+      // Symétrie conjuguée (équivalent à csym_forçage())
+      Y[0].imag(0);
+      Y[h].imag(0);
+      pour(auto i = 1; i < h; i++)
+        Y[n - i] = conj(Y[i]);
+    }
+    sinon
+    {
+      pour(auto i = 0; i < n; i++)
+        x2(i) = x(i);
+      cplan->step(x2, y, oui);
+    }
+  }
+};
+
+/** @brief Plan de TFR inverse, pour un signal réel.
+ *
+ *  L'entrée est le spectre complet (dimension n), supposé à symétrie hermitienne :
+ *  seuls les n/2+1 premiers points sont utilisés.
+ *  Si n est pair, une seule TFR inverse de dimension n/2 est calculée
+ *  (algorithme inverse de celui de RTFRPlan). */
+template<typename T>
+struct IRTFRPlan: FiltreGen<complex<T>, T>
+{
+  using cT = complex<T>;
+
+  entier n = -1;
+  sptr<FFTPlan> cplan;
+  Vecteur<cT> rotations, X2, x2;
+
+  IRTFRPlan(entier n)
+  {
+    configure(n);
+  }
+  void configure(entier n)
+  {
+    this->n = n;
+
+    si(n > 0)
+    {
+      si((n & 1) == 0)
+      {
+        cplan = tfrplan_création(n/2, non);
+        rotations = itfr_rotation<T>(n);
+        X2.resize(n/2);
+        x2.resize(n/2);
+      }
+      sinon
+      {
+        cplan = tfrplan_création(n, non);
+        X2.resize(n);
+        x2.resize(n);
+      }
+    }
+  }
+  void step(const Vecteur<cT> &X, Vecteur<T> &y)
+  {
+    si(X.rows() != n)
+      configure(X.rows());
+    y.resize(n);
     si((n & 1) == 0)
     {
-      y.resize(n);
-      Vecteur<cT> x2(n/2);
+      const cT J(0, 1);
+      const T g = 1 / sqrt((T) 2);
 
+      const cT *xs = X.data(), *rt = rotations.data();
+      cT *x2s = X2.data();
       pour(auto i = 0; i < n / 2; i++)
       {
-        x2(i).real(x(2*i));
-        x2(i).imag(x(2*i+1));
+        soit Xi = xs[i], Xp = conj(xs[n/2-i]);
+        x2s[i] = g * ((Xi + Xp) + J * (Xi - Xp) * rt[i]);
       }
 
-      // Compute n/2 FFT points in X
-      soit Xt = cplan->step(x2);
+      cplan->step(X2, x2, non);
 
-      const cT j2(0, 0.5 / sqrt(2)), r2(0.5 / sqrt(2), 0);
+      // x2(i) = y(2i) + j y(2i+1)
+      memcpy(y.data(), (const void *) x2.data(), n * sizeof(T));
+    }
+    sinon
+    {
+      X2(0) = X(0);
+      pour(auto i = 1; i <= n / 2; i++)
+      {
+        X2(i)   = X(i);
+        X2(n-i) = conj(X(i));
+      }
+      cplan->step(X2, x2, non);
+      pour(auto i = 0; i < n; i++)
+        y(i) = x2(i).real();
+    }
+  }
+};
+
+
+
+
+bouléen tfr_radix_mixte = oui;
+
+/** @brief Décomposition de n en facteurs 4, 2, 3, 5, 7
+ *  (vecteur vide si n comporte un autre facteur premier). */
+static vector<entier> tfr_factorise(entier n)
+{
+  vector<entier> facteurs;
+  tantque((n % 4) == 0)
+  {
+    facteurs.push_back(4);
+    n /= 4;
+  }
+  pour(auto p: {2, 3, 5, 7})
+  {
+    tantque((n % p) == 0)
+    {
+      facteurs.push_back(p);
+      n /= p;
+    }
+  }
+  si(n != 1)
+    facteurs.clear();
+  retourne facteurs;
+}
 
-      pour(auto i = 0; i <= n / 2; i++)
+/** @brief Papillon de base radix P (TFD de dimension P, non normalisée)
+ *
+ *  Pour P impair, on exploite la symétrie des coefficients :
+ *  @f$y_t = a_0 + \sum_r \cos(2\pi rt/P) (a_r + a_{P-r}) \mp \mathbf{i} \sum_r \sin(2\pi rt/P) (a_r - a_{P-r})@f$
+ *  (cs contient les cosinus et sinus, pour r,t = 1 ... (P-1)/2). */
+template<entier P, bouléen avant>
+inline void tfr_papillon(cfloat *a, const float *cs)
+{
+  si constexpr(P == 2)
+  {
+    soit t = a[1];
+    a[1] = a[0] - t;
+    a[0] = a[0] + t;
+  }
+  sinon si constexpr(P == 4)
+  {
+    soit b0 = a[0] + a[2], b1 = a[0] - a[2],
+         b2 = a[1] + a[3], d  = a[1] - a[3];
+    // (-i ou +i) * d
+    soit b3 = avant ? cfloat(d.imag(), -d.real()) : cfloat(-d.imag(), d.real());
+    a[0] = b0 + b2;
+    a[1] = b1 + b3;
+    a[2] = b0 - b2;
+    a[3] = b1 - b3;
+  }
+  sinon
+  {
+    constexpr entier H = (P - 1) / 2;
+    cfloat s[H], d[H];
+    soit a0 = a[0], y0 = a[0];
+    pour(auto r = 0; r < H; r++)
+    {
+      s[r] = a[r+1] + a[P-1-r];
+      d[r] = a[r+1] - a[P-1-r];
+      y0 += s[r];
+    }
+    pour(auto t = 0; t < H; t++)
+    {
+      cfloat c = a0, e = 0;
+      pour(auto r = 0; r < H; r++)
       {
-        cT X1, X2;
+        c += cs[2*(t*H+r)]   * s[r];
+        e += cs[2*(t*H+r)+1] * d[r];
+      }
+      // (-i ou +i) * e
+      soit ie = avant ? cfloat(e.imag(), -e.real()) : cfloat(-e.imag(), e.real());
+      a[t+1]   = c + ie;
+      a[P-1-t] = c - ie;
+    }
+    a[0] = y0;
+  }
+}
 
-        si(i == n/2)
-          X1 = Xt(0);
-        sinon
-          X1 = Xt(i);
+/** @brief TFR à base mixte (4, 2, 3, 5, 7), algorithme de Stockham (décimation en fréquence).
+ *
+ *  Chaque étage de base p transforme des sous-séquences de dimension l = p.m
+ *  (avec un pas s), et écrit le résultat dans le tampon alterné :
+ *  @f[
+ *  y_{q + s(pk+t)} = W_l^{kt} \cdot \sum_{r=0}^{p-1} x_{q+s(k+rm)} W_p^{rt}
+ *  @f]
+ *  Les facteurs de rotation @f$W_l^{kt}@f$ de chaque étage sont pré-calculés et stockés
+ *  de manière contiguë, dans l'ordre de parcours. */
+struct TFRMixte
+{
+  struct Etage
+  {
+    entier p, m, s;
+    // Facteurs de rotation : m * (p - 1) valeurs
+    Veccf rot;
+    // Cosinus / sinus du papillon (p impair)
+    Vecf cs;
+  };
+  vector<Etage> etages;
+  entier n = 0;
 
-        si(i > 0)
-          X2 = Xt(n/2-i);
-        sinon
-          X2 = Xt(0);
+  bouléen configure(entier n)
+  {
+    this->n = n;
+    etages.clear();
+    soit facteurs = tfr_factorise(n);
+    si(facteurs.empty())
+      retourne non;
+
+    entier l = n, s = 1;
+    pour(auto p: facteurs)
+    {
+      Etage e;
+      e.p = p;
+      e.m = l / p;
+      e.s = s;
+      e.rot.resize(e.m * (p - 1));
+      pour(auto k = 0; k < e.m; k++)
+        pour(auto t = 1; t < p; t++)
+          e.rot(k * (p - 1) + t - 1) = std::polar<double>(1.0, (-2 * π * k * t) / l);
+      si(p & 1)
+      {
+        soit H = (p - 1) / 2;
+        e.cs.resize(2 * H * H);
+        pour(auto t = 0; t < H; t++)
+        {
+          pour(auto r = 0; r < H; r++)
+          {
+            e.cs(2*(t*H+r))   = cos((2 * π * (r+1) * (t+1)) / p);
+            e.cs(2*(t*H+r)+1) = sin((2 * π * (r+1) * (t+1)) / p);
+          }
+        }
+      }
+      etages.push_back(e);
+      l /= p;
+      s *= p;
+    }
+    retourne oui;
+  }
 
-        y(i) = r2 * (X1 + conj(X2)) - j2 *  (X1 - conj(X2)) * rotations(i);
+  template<entier P, bouléen avant>
+  static void etage(const Etage &e, const cfloat *x, cfloat *y)
+  {
+    soit m = e.m, s = e.s;
+    soit rot = e.rot.data();
+    soit cs  = e.cs.data();
+    cfloat a[P];
+    pour(auto k = 0; k < m; k++)
+    {
+      soit w = rot + k * (P - 1);
+      pour(auto q = 0; q < s; q++)
+      {
+        pour(auto r = 0; r < P; r++)
+          a[r] = x[q + s * (k + r * m)];
+        tfr_papillon<P, avant>(a, cs);
+        soit yk = y + q + s * P * k;
+        yk[0] = a[0];
+        pour(auto t = 1; t < P; t++)
+        {
+          si constexpr(avant)
+            yk[s * t] = a[t] * w[t-1];
+          sinon
+            yk[s * t] = a[t] * conj(w[t-1]);
+        }
       }
-      csym_forçage(y);
     }
+  }
+
+  template<bouléen avant>
+  static void etage(const Etage &e, const cfloat *x, cfloat *y)
+  {
+    switch(e.p)
+    {
+    case 2: etage<2, avant>(e, x, y); break;
+    case 3: etage<3, avant>(e, x, y); break;
+    case 4: etage<4, avant>(e, x, y); break;
+    case 5: etage<5, avant>(e, x, y); break;
+    case 7: etage<7, avant>(e, x, y); break;
+    default: échec("TFR mixte : base non supportée ({}).", e.p);
+    }
+  }
+
+  /** @param scratch Tampon de travail (dimension n), distinct de x et y */
+  void step(const Veccf &x, Veccf &y, Veccf &scratch, bouléen avant) const
+  {
+    y.resize(n);
+    scratch.resize(n);
+
+    soit ne = (entier) etages.size();
+
+    // Le dernier étage doit écrire dans y
+    cfloat *tampons[2] = {y.data(), scratch.data()};
+    soit idx = (ne & 1) ? 0 : 1;
+    const cfloat *src = x.data();
+
+    pour(auto i = 0; i < ne; i++)
+    {
+      soit dst = tampons[idx];
+      si(avant)
+        etage<oui>(etages[i], src, dst);
+      sinon
+        etage<non>(etages[i], src, dst);
+      src = dst;
+      idx = 1 - idx;
+    }
+
+    y *= 1.0f / sqrt((float) n);
+  }
+};
+
+
+/** @brief Papillon de base P (même calcul que tfr_papillon()),
+ *  sur des parties réelles et imaginaires séparées. */
+template<entier P, bouléen avant>
+inline void tfr_papillon_ri(float *ar, float *ai, const float *cs)
+{
+  si constexpr(P == 2)
+  {
+    soit tr = ar[1], ti = ai[1];
+    ar[1] = ar[0] - tr;
+    ai[1] = ai[0] - ti;
+    ar[0] += tr;
+    ai[0] += ti;
+  }
+  sinon si constexpr(P == 4)
+  {
+    soit b0r = ar[0] + ar[2], b0i = ai[0] + ai[2],
+         b1r = ar[0] - ar[2], b1i = ai[0] - ai[2],
+         b2r = ar[1] + ar[3], b2i = ai[1] + ai[3],
+         dr  = ar[1] - ar[3], di  = ai[1] - ai[3];
+    // (-i ou +i) * d
+    soit b3r = avant ? di : -di, b3i = avant ? -dr : dr;
+    ar[0] = b0r + b2r; ai[0] = b0i + b2i;
+    ar[1] = b1r + b3r; ai[1] = b1i + b3i;
+    ar[2] = b0r - b2r; ai[2] = b0i - b2i;
+    ar[3] = b1r - b3r; ai[3] = b1i - b3i;
+  }
+  sinon
+  {
+    constexpr entier H = (P - 1) / 2;
+    float s_re[H], s_im[H], d_re[H], d_im[H];
+    soit a0r = ar[0], a0i = ai[0], y0r = ar[0], y0i = ai[0];
+    pour(auto r = 0; r < H; r++)
+    {
+      s_re[r] = ar[r+1] + ar[P-1-r];
+      s_im[r] = ai[r+1] + ai[P-1-r];
+      d_re[r] = ar[r+1] - ar[P-1-r];
+      d_im[r] = ai[r+1] - ai[P-1-r];
+      y0r += s_re[r];
+      y0i += s_im[r];
+    }
+    pour(auto t = 0; t < H; t++)
+    {
+      float cr = a0r, ci = a0i, er = 0, ei = 0;
+      pour(auto r = 0; r < H; r++)
+      {
+        cr += cs[2*(t*H+r)]   * s_re[r];
+        ci += cs[2*(t*H+r)]   * s_im[r];
+        er += cs[2*(t*H+r)+1] * d_re[r];
+        ei += cs[2*(t*H+r)+1] * d_im[r];
+      }
+      // (-i ou +i) * e
+      soit ier = avant ? ei : -ei, iei = avant ? -er : er;
+      ar[t+1]   = cr + ier;
+      ai[t+1]   = ci + iei;
+      ar[P-1-t] = cr - ier;
+      ai[P-1-t] = ci - iei;
+    }
+    ar[0] = y0r;
+    ai[0] = y0i;
+  }
+}
+
+/** @brief Etage de la TFR à base mixte, pour plusieurs transformées entrelacées.
+ *
+ *  Entrelacer nb transformées (élément i de la transformée j à l'indice i.nb + j)
+ *  revient à multiplier le pas s de chaque étage par nb : la boucle interne (sur q)
+ *  porte alors sur des éléments contigus, et les parties réelles / imaginaires
+ *  étant séparées, elle est vectorisée par le compilateur. */
+template<entier P, bouléen avant>
+static void tfr_mixte_lot_etage(const TFRMixte::Etage &e,
+                                const float *__restrict xr, const float *__restrict xi,
+                                float *__restrict yr, float *__restrict yi, entier s)
+{
+  soit m = e.m;
+  soit rot = (const float *) e.rot.data();
+  soit cs  = e.cs.data();
+  pour(auto k = 0; k < m; k++)
+  {
+    soit w = rot + 2 * k * (P - 1);
+#   pragma GCC ivdep
+    pour(auto q = 0; q < s; q++)
+    {
+      float ar[P], ai[P];
+      pour(auto r = 0; r < P; r++)
+      {
+        ar[r] = xr[q + s * (k + r * m)];
+        ai[r] = xi[q + s * (k + r * m)];
+      }
+      tfr_papillon_ri<P, avant>(ar, ai, cs);
+      soit o = q + s * P * k;
+      yr[o] = ar[0];
+      yi[o] = ai[0];
+      pour(auto t = 1; t < P; t++)
+      {
+        soit wr = w[2*(t-1)], wi = avant ? w[2*(t-1)+1] : -w[2*(t-1)+1];
+        yr[o + s * t] = ar[t] * wr - ai[t] * wi;
+        yi[o + s * t] = ar[t] * wi + ai[t] * wr;
+      }
+    }
+  }
+}
+
+template<bouléen avant>
+static void tfr_mixte_lot_etage(const TFRMixte::Etage &e, const float *xr, const float *xi,
+                                float *yr, float *yi, entier s)
+{
+  switch(e.p)
+  {
+  case 2: tfr_mixte_lot_etage<2, avant>(e, xr, xi, yr, yi, s); break;
+  case 3: tfr_mixte_lot_etage<3, avant>(e, xr, xi, yr, yi, s); break;
+  case 4: tfr_mixte_lot_etage<4, avant>(e, xr, xi, yr, yi, s); break;
+  case 5: tfr_mixte_lot_etage<5, avant>(e, xr, xi, yr, yi, s); break;
+  case 7: tfr_mixte_lot_etage<7, avant>(e, xr, xi, yr, yi, s); break;
+  default: échec("TFR mixte : base non supportée ({}).", e.p);
+  }
+}
+
+#if TSD_TFR_SIMD
+// Mêmes étages, compilés pour AVX2 / FMA et AVX-512 (tout est inliné)
+template<bouléen avant>
+__attribute__((target("avx2,fma"), flatten))
+static void tfr_mixte_lot_etage_avx2(const TFRMixte::Etage &e, const float *xr, const float *xi,
+                                     float *yr, float *yi, entier s)
+{
+  tfr_mixte_lot_etage<avant>(e, xr, xi, yr, yi, s);
+}
+
+template<bouléen avant>
+__attribute__((target("avx512f"), flatten))
+static void tfr_mixte_lot_etage_avx512(const TFRMixte::Etage &e, const float *xr, const float *xi,
+                                       float *yr, float *yi, entier s)
+{
+  tfr_mixte_lot_etage<avant>(e, xr, xi, yr, yi, s);
+}
+#endif
+
+/** @brief Calcul (non normalisé) de nb TFR à base mixte entrelacées.
+ *
+ *  @param re, im  Deux tampons (dimension n.nb) pour les parties réelles et imaginaires,
+ *                 l'entrée étant dans le premier.
+ *  @returns       Index du tampon contenant le résultat. */
+template<bouléen avant>
+static entier tfr_mixte_lot(const TFRMixte &M, float *re[2], float *im[2], entier nb)
+{
+  soit niveau = tfr_simd_niveau();
+  entier idx = 0;
+  pour(auto &e: M.etages)
+  {
+    soit s = e.s * nb;
+    soit xr = re[idx], xi = im[idx], yr = re[1-idx], yi = im[1-idx];
+#   if TSD_TFR_SIMD
+    si(niveau == 3)
+      tfr_mixte_lot_etage_avx512<avant>(e, xr, xi, yr, yi, s);
+    sinon si(niveau == 2)
+      tfr_mixte_lot_etage_avx2<avant>(e, xr, xi, yr, yi, s);
     sinon
+#   endif
+      tfr_mixte_lot_etage<avant>(e, xr, xi, yr, yi, s);
+    idx = 1 - idx;
+  }
+  retourne idx;
+}
+
+/** @brief Tables (en lecture seule) associées à une dimension de TFR.
+ *
+ *  Ces tables ne dépendent ni du sens de la transformée, ni de la normalisation :
+ *  elles sont partagées (via le cache, voir tfr_tables()) entre tous les plans
+ *  de même dimension, y compris entre plusieurs threads. */
+struct TFRTables
+{
+  entier n = 0, n2 = 0;
+  bouléen mode_mixte = non, avec_mixte = non;
+  Veccf rotations, rotations_etages, chirp;
+  TFRMixte mixte;
+
+  TFRTables(entier n)
+  {
+    this->n = n;
+    n2 = n;
+
+    // Uniquement des facteurs 2, 3, 5 et 7 ?
+    // (la décomposition est aussi utilisée pour les calculs par lots, y compris pour n = 2^k)
+    avec_mixte = mixte.configure(n);
+
+    // Pas une puissance de 2 : algorithme à base mixte
+    si(((n & (n - 1)) != 0) && tfr_radix_mixte && avec_mixte)
     {
-      Vecteur<cT> y1 = x.as_complex();
-      cplan->step(y1, y);
+      mode_mixte = oui;
+      retourne;
     }
+
+    // Impair et pas une puissance de 2 : CZT
+    si(((n & (n - 1)) != 0) && ((n & 1) != 0))
+    {
+      //msg("Avertissement : FFT sur n != 2^k (n = %d)", n);
+      n2 = prochaine_puissance_de_2(2*n-1);
+      soit t = square(linspace(-(n-1), n-1, 2*n-1)) / 2;
+      t *= -2*π/n;
+      // t = -2pi * [-(n-1)/n, -(n-2)/n, ... 0, ..., (n-1)/n]
+      chirp = polar(t);
+    }
+    rotations = tfr_rotation<float>(n2);
+    si((n2 & (n2 - 1)) == 0)
+      rotations_etages = tfr_rotations_etages(rotations);
+  }
+
+  /** Occupation mémoire approximative, en octets */
+  entier octets() const
+  {
+    entier nb = rotations.rows() + rotations_etages.rows() + chirp.rows();
+    pour(auto &e: mixte.etages)
+      nb += e.rot.rows() + e.cs.rows() / 2;
+    retourne sizeof(TFRTables) + nb * sizeof(cfloat);
   }
 };
 
+/** @brief Cache (commun à tous les threads) des tables de TFR,
+ *  avec éviction LRU au-delà d'une occupation mémoire maximale. */
+struct TFRCache
+{
+  // Clé : dimension, algorithme à base mixte autorisé
+  using Clé = pair<entier, bouléen>;
+  using Entrée = pair<Clé, sptr<const TFRTables>>;
+
+  mutex mtx;
+  // Entrées, de la plus récemment utilisée à la plus ancienne
+  list<Entrée> lru;
+  map<Clé, list<Entrée>::iterator> index;
+  TFRCacheStats stats;
+  entier octets_max = 64 * 1024 * 1024;
+
+  sptr<const TFRTables> get(entier n)
+  {
+    Clé clé{n, tfr_radix_mixte};
+    {
+      const lock_guard<mutex> lock(mtx);
+      soit it = index.find(clé);
+      si(it != index.end())
+      {
+        stats.nb_succès++;
+        lru.splice(lru.begin(), lru, it->second);
+        retourne it->second->second;
+      }
+      stats.nb_défauts++;
+    }
+
+    // Calcul des tables en dehors de la section critique
+    soit tables = make_shared<const TFRTables>(n);
 
+    const lock_guard<mutex> lock(mtx);
+    // Un autre thread a pu calculer les mêmes tables entre-temps
+    soit it = index.find(clé);
+    si(it != index.end())
+    {
+      lru.splice(lru.begin(), lru, it->second);
+      retourne it->second->second;
+    }
+    lru.push_front({clé, tables});
+    index[clé] = lru.begin();
+    stats.nb_entrées++;
+    stats.octets += tables->octets();
+    évictions(1);
+    retourne tables;
+  }
 
+  /** Supprime les entrées les plus anciennes tant que la limite est dépassée
+   *  (les nb_gardées entrées les plus récentes sont conservées). */
+  void évictions(entier nb_gardées)
+  {
+    tantque((stats.octets > octets_max) && ((entier) lru.size() > nb_gardées))
+    {
+      soit &e = lru.back();
+      stats.octets -= e.second->octets();
+      stats.nb_entrées--;
+      stats.nb_évictions++;
+      index.erase(e.first);
+      lru.pop_back();
+    }
+  }
+};
+
+static TFRCache &tfr_cache()
+{
+  static TFRCache cache;
+  retourne cache;
+}
+
+static sptr<const TFRTables> tfr_tables(entier n)
+{
+  retourne tfr_cache().get(n);
+}
+
+TFRCacheStats tfr_cache_stats()
+{
+  soit &c = tfr_cache();
+  const lock_guard<mutex> lock(c.mtx);
+  retourne c.stats;
+}
+
+void tfr_cache_config(entier octets_max)
+{
+  soit &c = tfr_cache();
+  const lock_guard<mutex> lock(c.mtx);
+  c.octets_max = octets_max;
+  c.évictions(0);
+}
+
+void tfr_cache_vide()
+{
+  soit &c = tfr_cache();
+  const lock_guard<mutex> lock(c.mtx);
+  c.lru.clear();
+  c.index.clear();
+  c.stats = TFRCacheStats();
+}
 
 struct TFRPlanDefaut: FiltreGen<cfloat>, FFTPlan
 {
   bouléen normaliser  = oui, avant = oui;
   entier n = 0, n2 = 0;
-  Veccf scratch, rotations, chirp;
+  // Tampons de travail, propres à chaque plan
+  Veccf scratch, x_copie;
+  // Tables partagées
+  sptr<const TFRTables> tables;
   sptr<FFTPlan> sousplan;
 
   TFRPlanDefaut(entier n = -1, bouléen avant = oui, bouléen normalize = oui)
@@ -377,31 +1186,19 @@ struct TFRPlanDefaut: FiltreGen<cfloat>, FFTPlan
     si(n == -1)
       retourne;
 
-    n2 = n;
+    tables = tfr_tables(n);
+    n2     = tables->n2;
 
-    // Pas une puissance de 2 ?
-    si((n & (n - 1)) != 0)
+    // n pair, pas une puissance de 2, et pas de base mixte : décompose tant que pair
+    si(!tables->mode_mixte && ((n & (n - 1)) != 0) && ((n & 1) == 0))
     {
-      // n est pair
-      si((n & 1) == 0)
-      {
-        // Décompose tant que pair
+      si(!sousplan)
         sousplan = make_shared<TFRPlanDefaut>(n / 2, avant, normalize);
-      }
       sinon
-      {
-        //msg("Avertissement : FFT sur n != 2^k (n = %d)", n);
-        n2 = prochaine_puissance_de_2(2*n-1);
-        // CZT
-        soit t = square(linspace(-(n-1), n-1, 2*n-1)) / 2;
-        t *= -2*π/n;
-        // t = -2pi * [-(n-1)/n, -(n-2)/n, ... 0, ..., (n-1)/n]
-        chirp = polar(t);
-      }
+        sousplan->configure(n / 2, avant, normalize);
     }
     //msg("plan fft : n = {}, n2 = {}", n, n2);
     scratch.resize(n2);
-    rotations = tfr_rotation<float>(n2);
   }
 
   void step(const Veccf &x, Veccf &y)
@@ -416,9 +1213,22 @@ struct TFRPlanDefaut: FiltreGen<cfloat>, FFTPlan
     si((entier) n != x.rows())
       configure(x.rows(), this->avant, this->normaliser);
 
-    si(n2 != n)
+    soit &T = *tables;
+
+    si(T.mode_mixte)
     {
-      y = tfr_czt_impl(x, n2, rotations, chirp);
+      si(x.data() == y.data())
+      {
+        x_copie.resize(n);
+        x_copie.copie(x);
+        T.mixte.step(x_copie, y, scratch, avant);
+      }
+      sinon
+        T.mixte.step(x, y, scratch, avant);
+    }
+    sinon si(n2 != n)
+    {
+      y = tfr_czt_impl(x, n2, T.rotations_etages, T.chirp);
       si(!avant)
       {
         y = tfr2itfr(y);
@@ -431,9 +1241,9 @@ struct TFRPlanDefaut: FiltreGen<cfloat>, FFTPlan
       {
         y.resize(n);
         si(avant)
-          tfr_radix2<float, float, oui>(y, x, scratch, rotations);
+          tfr_radix2<float, float, oui>(y, x, scratch, T.rotations_etages);
         sinon
-          tfr_radix2<float, float, non>(y, x, scratch, rotations);
+          tfr_radix2<float, float, non>(y, x, scratch, T.rotations_etages);
       }
       sinon
       {
@@ -450,13 +1260,13 @@ struct TFRPlanDefaut: FiltreGen<cfloat>, FFTPlan
 
         si(avant)
         {
-          y.head(n/2) = E + rotations.head(n/2) * O;
-          y.tail(n/2) = E + rotations.tail(n/2) * O;
+          y.head(n/2) = E + T.rotations.head(n/2) * O;
+          y.tail(n/2) = E + T.rotations.tail(n/2) * O;
         }
         sinon
         {
-          y.head(n/2) = E + rotations.head(n/2).conjugate() * O;
-          y.tail(n/2) = E + rotations.tail(n/2).conjugate() * O;
+          y.head(n/2) = E + T.rotations.head(n/2).conjugate() * O;
+          y.tail(n/2) = E + T.rotations.tail(n/2).conjugate() * O;
         }
         si(normaliser)
           y *= 1 / sqrt(2.0f);
@@ -464,6 +1274,88 @@ struct TFRPlanDefaut: FiltreGen<cfloat>, FFTPlan
     }
   }
 
+  void step_batch(const Tabcf &X, Tabcf &Y, entier axe, bouléen avant)
+  {
+    assertion_msg((axe == 0) || (axe == 1), "step_batch : axe invalide ({}).", axe);
+
+    soit nr = X.rows(), nc = X.cols();
+    // Dimension des transformées, nombre de transformées
+    soit nt = (axe == 0) ? nr : nc,
+         ns = (axe == 0) ? nc : nr;
+
+    si((nt == 0) || (ns == 0))
+    {
+      Y.resize(nr, nc);
+      retourne;
+    }
+
+    si(nt != n)
+      configure(nt, this->avant, this->normaliser);
+
+    // Grandes puissances de 2 : le calcul radix 2 vectorisé, transformée par transformée, est plus rapide
+    si(!tables->avec_mixte || (((nt & (nt - 1)) == 0) && (nt >= 1024)))
+    {
+      FFTPlan::step_batch(X, Y, axe, avant);
+      retourne;
+    }
+
+    // Si Y et X sont le même tableau, les données sont lues avant d'être écrites (par paquets)
+    Y.resize(nr, nc);
+
+    // Nombre de transformées entrelacées par paquet (tampons de l'ordre de 128 ko)
+    soit lot = max(1, min(16, 4096 / nt));
+    soit nb_paquets = (ns + lot - 1) / lot;
+    soit gain = 1.0f / sqrt((float) nt);
+    soit &M = tables->mixte;
+
+    const cfloat *px = X.data();
+    cfloat *py = Y.data();
+
+#   if LIBTSD_USE_OMP
+#   pragma omp parallel
+#   endif
+    {
+      // Tampons propres à chaque thread (conservés d'un appel à l'autre) : parties réelles / imaginaires séparées
+      thread_local Vecf tampon;
+      si(tampon.rows() < 4 * nt * lot)
+        tampon.resize(4 * nt * lot);
+      float *re[2] = {tampon.data(), tampon.data() + nt * lot},
+            *im[2] = {tampon.data() + 2 * nt * lot, tampon.data() + 3 * nt * lot};
+
+#     if LIBTSD_USE_OMP
+#     pragma omp for
+#     endif
+      pour(auto k = 0; k < nb_paquets; k++)
+      {
+        soit s0 = k * lot;
+        soit nb = min(lot, ns - s0);
+
+        // Pas entre deux éléments d'une transformée, et entre deux transformées
+        soit pas_elt = (axe == 0) ? 1 : nr,
+             pas_tr  = (axe == 0) ? nr : 1;
+
+        // Entrelacement : élément i de la transformée j à l'indice i.nb + j
+        pour(auto j = 0; j < nb; j++)
+        {
+          soit xj = px + (s0 + j) * pas_tr;
+          pour(auto i = 0; i < nt; i++)
+          {
+            re[0][i * nb + j] = xj[i * pas_elt].real();
+            im[0][i * nb + j] = xj[i * pas_elt].imag();
+          }
+        }
+
+        soit idx = avant ? tfr_mixte_lot<oui>(M, re, im, nb) : tfr_mixte_lot<non>(M, re, im, nb);
+
+        pour(auto j = 0; j < nb; j++)
+        {
+          soit yj = py + (s0 + j) * pas_tr;
+          pour(auto i = 0; i < nt; i++)
+            yj[i * pas_elt] = cfloat(re[idx][i * nb + j], im[idx][i * nb + j]) * gain;
+        }
+      }
+    }
+  }
 };
 
 fonction<sptr<FFTPlan>()> fftplan_defaut = []()
@@ -472,6 +1364,28 @@ fonction<sptr<FFTPlan>()> fftplan_defaut = []()
 };
 
 
+void FFTPlan::step_batch(const Tabcf &X, Tabcf &Y, entier axe, bouléen avant)
+{
+  assertion_msg((axe == 0) || (axe == 1), "step_batch : axe invalide ({}).", axe);
+
+  soit nr = X.rows(), nc = X.cols();
+  soit nt = (axe == 0) ? nr : nc,
+       ns = (axe == 0) ? nc : nr;
+
+  Y.resize(nr, nc);
+  // Tampons conservés d'un appel à l'autre
+  thread_local Veccf x, y;
+  x.resize(nt);
+  pour(auto k = 0; k < ns; k++)
+  {
+    pour(auto i = 0; i < nt; i++)
+      x(i) = (axe == 0) ? X(i, k) : X(k, i);
+    step(x, y, avant);
+    pour(auto i = 0; i < nt; i++)
+      ((axe == 0) ? Y(i, k) : Y(k, i)) = y(i);
+  }
+}
+
 sptr<FFTPlan> tfrplan_création(entier n, bouléen avant, bouléen normalize)
 {
   soit res = fftplan_defaut();
@@ -485,6 +1399,29 @@ sptr<FiltreGen<float, cfloat>> rtfrplan_création(entier n)
   retourne make_shared<RTFRPlan<float>>(n);
 }
 
+sptr<FiltreGen<cfloat, float>> irtfrplan_création(entier n)
+{
+  retourne make_shared<IRTFRPlan<float>>(n);
+}
+
+Veccf tfr_calcul(const Veccf &x, bouléen avant)
+{
+  // Un plan par thread : les tables sont partagées via le cache,
+  // les tampons de travail restent propres à chaque thread.
+  thread_local sptr<FFTPlan> plan;
+  si(!plan)
+    plan = fftplan_defaut();
+  retourne plan->step(x, avant);
+}
+
+Veccf rtfr_calcul(const Vecf &x)
+{
+  thread_local RTFRPlan<float> plan(-1);
+  Veccf y;
+  plan.step(x, y);
+  retourne y;
+}
+
 
 // Produit de corrélation effectué dans le domaine fréquentiel
 template<typename T>
@@ -949,9 +1886,19 @@ struct FiltreFFTRIF: FiltreGen<T>
   OLA<cfloat> ola;
   Veccf H;
 
-  FiltreFFTRIF(const Vecf &h)
+  FiltreFFTRIF(const Vecf &h, entier Ne)
   {
+    soit K = h.rows();
+    // Par défaut, blocs de 512 échantillons (ou plus, pour les filtres longs)
+    si(Ne <= 0)
+    {
+      Ne = 512;
+      si(prochaine_puissance_de_2(Ne + K) - Ne > Ne)
+        Ne = prochaine_puissance_de_2(2 * K) - K;
+    }
+
     FiltreFFTConfig ola_config;
+    ola_config.dim_blocs_temporel = Ne;
     ola_config.nb_zeros_min       = h.rows(); // -1 ?
     ola_config.traitement_freq    = [&](Veccf &X)
     {
@@ -959,6 +1906,11 @@ struct FiltreFFTRIF: FiltreGen<T>
     };
     ola.configure(ola_config);
 
+    // Le recouvrement (N - Ne échantillons) doit tenir dans un bloc
+    si(ola.N_zeros > ola.Ne)
+      échec("filtre_rif_fft : dimension de bloc trop petite (Ne = {}, {} coefficients, N = {}).",
+            ola.Ne, h.rows(), ola.N);
+
     soit h2 = Vecf::zeros(ola.N);
     h2.tail(h.rows()) = h;
     H = fft(h2);
@@ -973,7 +1925,10 @@ struct FiltreFFTRIF: FiltreGen<T>
   }
   void step(const Vecteur<T> &x, Vecteur<T> &y)
   {
-    y = real(ola.Filtre<cfloat, cfloat, FiltreFFTConfig>::step(x.as_complex()));
+    si constexpr(est_complexe<T>())
+      ola.step(x, y);
+    sinon
+      y = real(ola.Filtre<cfloat, cfloat, FiltreFFTConfig>::step(x.as_complex()));
   }
 };
 
@@ -984,9 +1939,9 @@ namespace tsd::filtrage {
 
 // Filtre OLA
 template<typename T>
-sptr<FiltreGen<T>> filtre_rif_fft(const Vecf &h)
+sptr<FiltreGen<T>> filtre_rif_fft(const Vecf &h, entier dim_bloc)
 {
-  retourne make_shared<tsd::fourier::FiltreFFTRIF<T>>(h);
+  retourne make_shared<tsd::fourier::FiltreFFTRIF<T>>(h, dim_bloc);
 }
 
 }
@@ -1227,6 +2182,7 @@ struct Spectrum: Filtre<cfloat,float,SpectrumConfig>
   }
 
   Veccf yt;
+  Tabcf xs;
   void step(const Vecteur<cfloat> &x, Vecf &y)
   {
     soit &config = Configurable<SpectrumConfig>::config;
@@ -1241,15 +2197,16 @@ struct Spectrum: Filtre<cfloat,float,SpectrumConfig>
     // Mode multi-threadé
     si(config.nsubs > 1)
     {
+      // Une colonne par sous-bloc, toutes les FFT en un seul appel
+      xs.resize(Nf, config.nsubs);
+      pour(auto i = 0; i < config.nsubs; i++)
+        pour(auto j = 0; j < Nf; j++)
+          xs(j, i) = x(i * Nf + j) * f(j);
+      plan->step_batch(xs, xs, 0, oui);
+
       Vecf yft[config.nsubs];
-#     if LIBTSD_USE_OMP
-#     pragma omp parallel pour
-#     endif
       pour(auto i = 0; i < config.nsubs; i++)
-      {
-        soit tmp = plan->step(x.segment(i * Nf, Nf) * f);
-        yft[i] = fftshift(abs2(tmp));
-      }
+        yft[i] = fftshift(abs2(xs.col(i)));
       // si balayage, il faut faire un mag_moy un peu différent...
       // On suppose dans tous les cas que le paquet reçu (dim = BS)
       // contient l'ensemble du balayage
@@ -1441,10 +2398,10 @@ Vecteur<cfloat> délais<cfloat>(const Vecteur<cfloat> &x, float delay);
 
 namespace tsd::filtrage {
 template
-sptr<FiltreGen<float>> filtre_rif_fft<float>(const Vecf &h);
+sptr<FiltreGen<float>> filtre_rif_fft<float>(const Vecf &h, entier dim_bloc);
 
 template
-sptr<FiltreGen<cfloat>> filtre_rif_fft<cfloat>(const Vecf &h);
+sptr<FiltreGen<cfloat>> filtre_rif_fft<cfloat>(const Vecf &h, entier dim_bloc);
 }
 
 namespace tsd::tf {
@@ -10,10 +10,16 @@ tuple<Vecf, Vecf> psd_welch(const Veccf &x, entier N, cstring fen)
        S     = Vecf::zeros(N),
        f     = tsd::filtrage::fenêtre(fen, N, non);
 
+  // Plan et tampons alloués une seule fois
+  soit plan = tfrplan_création(N);
+  Veccf xp(N), X(N);
+
   pour(auto i = 0; i + N < x.rows(); i += N/2)
   {
-    soit xp = x.segment(i, N) * f;
-    S += fftshift(abs2(fft(xp)));
+    pour(auto k = 0; k < N; k++)
+      xp(k) = x(i + k) * f(k);
+    plan->step(xp, X, oui);
+    S += fftshift(abs2(X));
   }
 
   retourne {freqs, pow2db(S)};
@@ -0,0 +1,359 @@
+#include "tsd/tsd.hpp"
+#include "tsd/filtrage.hpp"
+#include "tsd/fourier.hpp"
+#include <cstring>
+
+using namespace std;
+
+namespace tsd::fourier
+{
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define TSD_PARTITION_SIMD 1
+#else
+# define TSD_PARTITION_SIMD 0
+#endif
+
+// y += h . x (produit terme à terme), vecteurs complexes de dimension n
+// stockés en deux plans : parties réelles [0, n[, puis parties imaginaires [n, 2n[
+static inline void rif_partition_mac_noyau(const float * __restrict h, const float * __restrict x,
+                                           float * __restrict y, entier n)
+{
+  pour(auto k = 0; k < n; k++)
+  {
+    soit hr = h[k], hi = h[n + k], xr = x[k], xi = x[n + k];
+    y[k]     += hr * xr - hi * xi;
+    y[n + k] += hr * xi + hi * xr;
+  }
+}
+
+#if TSD_PARTITION_SIMD
+__attribute__((target("avx2,fma"), flatten))
+static void rif_partition_mac_avx2(const float *h, const float *x, float *y, entier n)
+{
+  rif_partition_mac_noyau(h, x, y, n);
+}
+
+__attribute__((target("avx512f"), flatten))
+static void rif_partition_mac_avx512(const float *h, const float *x, float *y, entier n)
+{
+  rif_partition_mac_noyau(h, x, y, n);
+}
+#endif
+
+static void rif_partition_mac(const float *h, const float *x, float *y, entier n)
+{
+# if TSD_PARTITION_SIMD
+  soit niveau = tfr_simd_niveau();
+  si(niveau == 3)
+    retourne rif_partition_mac_avx512(h, x, y, n);
+  si(niveau == 2)
+    retourne rif_partition_mac_avx2(h, x, y, n);
+# endif
+  rif_partition_mac_noyau(h, x, y, n);
+}
+
+/** @brief Convolution par partitions uniformes (overlap-save, ligne à retard fréquentielle)
+ *
+ *  Blocs de B échantillons, TFR de dimension N = 2B,
+ *  P = ceil(K / B) partitions de B coefficients, dont les spectres sont pré-calculés.
+ *  Pour chaque nouveau bloc d'entrée b :
+ *  @f[
+ *  Y = \sum_{p=0}^{P-1} H_p \cdot X_{b-p}
+ *  @f]
+ *  et les B derniers points de la TFR inverse de Y sont les B nouveaux échantillons de sortie.
+ *  Pour des données réelles, seuls les N/2+1 premiers points des spectres sont stockés / accumulés. */
+template<typename T>
+struct ConvolPartitions
+{
+  entier B = 0, N = 0, P = 0, nb_bins = 0;
+
+  // Index (circulaire) du dernier spectre d'entrée
+  entier pos = 0;
+
+  // Spectres des partitions du filtre (P x nb_bins),
+  // et spectres des P derniers blocs d'entrée (ligne à retard fréquentielle),
+  // puis spectre accumulé (nb_bins).
+  // Chaque spectre est stocké en deux plans (parties réelles, puis parties imaginaires),
+  // de manière à vectoriser simplement les produits fréquentiels.
+  Vecf H, X, Y;
+
+  // Fenêtre temporelle (deux blocs), sortie de la TFR inverse
+  Vecteur<T> fenêtre, yt;
+
+  // Spectre du bloc courant, spectre accumulé (format entrelacé, pour les plans TFR)
+  Veccf Xb, Yc;
+
+  // Plans (partagent les tables du cache TFR)
+  sptr<FFTPlan> plan, iplan;
+  sptr<FiltreGen<float, cfloat>> rplan;
+  sptr<FiltreGen<cfloat, float>> irplan;
+
+  void tfr(const Vecteur<T> &x, Veccf &Xs)
+  {
+    si constexpr(est_complexe<T>())
+      plan->step(x, Xs, oui);
+    sinon
+      rplan->step(x, Xs);
+  }
+
+  void configure(const Vecf &h, entier B)
+  {
+    soit K = h.rows();
+    this->B = B;
+    N       = 2 * B;
+    P       = max((K + B - 1) / B, (entier) 1);
+    nb_bins = est_complexe<T>() ? N : N / 2 + 1;
+    pos     = 0;
+
+    si constexpr(est_complexe<T>())
+    {
+      plan  = tfrplan_création(N, oui);
+      iplan = tfrplan_création(N, non);
+    }
+    sinon
+    {
+      rplan  = rtfrplan_création(N);
+      irplan = irtfrplan_création(N);
+    }
+
+    fenêtre = Vecteur<T>::zeros(N);
+    yt      = Vecteur<T>::zeros(N);
+    Xb      = Veccf::zeros(N);
+    Yc      = Veccf::zeros(N);
+    Y       = Vecf::zeros(2 * nb_bins);
+    X       = Vecf::zeros(2 * P * nb_bins);
+    H.resize(2 * P * nb_bins);
+
+    // Les plans sont normalisés (facteur 1 / sqrt(N) dans chaque sens),
+    // d'où le facteur sqrt(N) sur les spectres du filtre.
+    soit g = sqrt((float) N);
+    Vecteur<T> hp(N);
+    pour(auto p = 0; p < P; p++)
+    {
+      hp.setZero();
+      soit nc = min(B, K - p * B);
+      pour(auto i = 0; i < nc; i++)
+        hp(i) = h(p * B + i);
+      tfr(hp, Xb);
+      Xb *= g;
+      sépare(Xb, H.data() + 2 * p * nb_bins);
+    }
+  }
+
+  // Format entrelacé -> deux plans
+  void sépare(const Veccf &Z, float *z)
+  {
+    soit zs = Z.data();
+    pour(auto k = 0; k < nb_bins; k++)
+    {
+      z[k]           = zs[k].real();
+      z[nb_bins + k] = zs[k].imag();
+    }
+  }
+
+  // B échantillons d'entrée -> B échantillons de sortie (y peut être égal à x)
+  void bloc(const T *x, T *y)
+  {
+    // Overlap-save : fenêtre = [bloc précédent, bloc courant]
+    memmove(fenêtre.data(), fenêtre.data() + B, B * sizeof(T));
+    memcpy(fenêtre.data() + B, x, B * sizeof(T));
+
+    tfr(fenêtre, Xb);
+    sépare(Xb, X.data() + 2 * pos * nb_bins);
+
+    Y.setZero();
+    pour(auto p = 0; p < P; p++)
+    {
+      soit q = (pos - p + P) % P;
+      rif_partition_mac(H.data() + 2 * p * nb_bins, X.data() + 2 * q * nb_bins, Y.data(), nb_bins);
+    }
+
+    soit ys = Y.data();
+    soit yc = Yc.data();
+    pour(auto k = 0; k < nb_bins; k++)
+      yc[k] = cfloat(ys[k], ys[nb_bins + k]);
+
+    si constexpr(est_complexe<T>())
+      iplan->step(Yc, yt, non);
+    sinon
+      irplan->step(Yc, yt);
+
+    // Seuls les B derniers points sont exempts de repliement circulaire
+    memcpy(y, yt.data() + B, B * sizeof(T));
+    pos = (pos + 1) % P;
+  }
+};
+
+/** @brief Un niveau d'un filtre partitionné non uniforme
+ *
+ *  Convolution par partitions de dimension B (>= dimension des partitions du premier niveau B0),
+ *  portant sur les coefficients [o, o + K[ du filtre.
+ *  La sortie de ce niveau est retardée de o échantillons (o >= B - B0),
+ *  de manière à être disponible à chaque frontière de bloc du premier niveau. */
+template<typename T>
+struct NiveauPartitions
+{
+  ConvolPartitions<T> conv;
+  entier B = 0, nb_entrée = 0;
+  Vecteur<T> entrée, sortie;
+
+  // Tampon circulaire de sortie
+  Vecteur<T> fifo;
+  entier lecture = 0, nb_fifo = 0;
+
+  void configure(const Vecf &h, entier B, entier retard)
+  {
+    this->B = B;
+    conv.configure(h, B);
+    entrée    = Vecteur<T>::zeros(B);
+    sortie    = Vecteur<T>::zeros(B);
+    fifo      = Vecteur<T>::zeros(retard + B);
+    nb_entrée = 0;
+    lecture   = 0;
+    nb_fifo   = retard;
+  }
+
+  // c échantillons d'entrée (c divise B), c échantillons de sortie ajoutés à y
+  void step(const T *x, T *y, entier c)
+  {
+    soit cap = fifo.rows();
+    soit f   = fifo.data();
+    memcpy(entrée.data() + nb_entrée, x, c * sizeof(T));
+    nb_entrée += c;
+    si(nb_entrée == B)
+    {
+      conv.bloc(entrée.data(), sortie.data());
+      nb_entrée = 0;
+      soit e = (lecture + nb_fifo) % cap;
+      soit s = sortie.data();
+      pour(auto i = 0; i < B; i++)
+      {
+        f[e] = s[i];
+        e = (e + 1 == cap) ? 0 : e + 1;
+      }
+      nb_fifo += B;
+    }
+    assertion(nb_fifo >= c);
+    pour(auto i = 0; i < c; i++)
+    {
+      y[i] += f[lecture];
+      lecture = (lecture + 1 == cap) ? 0 : lecture + 1;
+    }
+    nb_fifo -= c;
+  }
+};
+
+template<typename T>
+struct FiltreRIFPartitions: FiltreGen<T>
+{
+  // Premier niveau (latence)
+  ConvolPartitions<T> conv0;
+  // Niveaux suivants (mode non uniforme)
+  vector<NiveauPartitions<T>> niveaux;
+
+  entier B = 0, nb_entrée = 0;
+  Vecteur<T> entrée;
+
+  FiltreRIFPartitions(const Vecf &h, entier B, bouléen non_uniforme)
+  {
+    soit K = h.rows();
+    si(B <= 0)
+      échec("filtre_rif_partition : dimension de partition invalide ({}).", B);
+    si(K == 0)
+      échec("filtre_rif_partition : filtre vide.");
+
+    this->B = B;
+    entrée  = Vecteur<T>::zeros(B);
+
+    // Mode non uniforme : partitions de dimension B.4^l pour le niveau l,
+    // qui commence au coefficient o_l = B.4^l - B (le plus tôt possible, compte-tenu de sa latence).
+    // Chaque niveau comporte 3 partitions, sauf le dernier qui couvre tous les coefficients restants.
+    entier fin0 = K;
+    si(non_uniforme)
+    {
+      entier Bl = B, o = 0, l = 0;
+      tantque(oui)
+      {
+        soit Bs = 4 * Bl, os = Bs - B;
+        // Dernier niveau si le suivant ne comporterait pas au moins 2 partitions
+        soit dernier = (K <= os + Bs);
+        soit fin     = dernier ? K : os;
+        si(l == 0)
+          fin0 = fin;
+        sinon
+        {
+          NiveauPartitions<T> niv;
+          niveaux.push_back(niv);
+          niveaux.back().configure(h.segment(o, fin - o), Bl, o);
+        }
+        si(dernier)
+          break;
+        Bl = Bs;
+        o  = os;
+        l++;
+      }
+    }
+    conv0.configure(h.head(fin0), B);
+  }
+
+  void bloc(const T *x, T *y)
+  {
+    pour(auto &niv: niveaux)
+      niv.step(x, y, B);
+  }
+
+  void step(const Vecteur<T> &x, Vecteur<T> &y)
+  {
+    soit n = x.rows();
+    // Seuls les blocs complets sont produits (pas de retard si n est multiple de B)
+    soit m = ((nb_entrée + n) / B) * B;
+    y.resize(m);
+
+    entier i = 0, j = 0;
+    // Complète le bloc en attente
+    si(nb_entrée > 0)
+    {
+      soit c = min(B - nb_entrée, n);
+      memcpy(entrée.data() + nb_entrée, x.data(), c * sizeof(T));
+      nb_entrée += c;
+      i = c;
+      si(nb_entrée == B)
+      {
+        conv0.bloc(entrée.data(), y.data());
+        bloc(entrée.data(), y.data());
+        nb_entrée = 0;
+        j = B;
+      }
+    }
+    pour(; i + B <= n; i += B, j += B)
+    {
+      conv0.bloc(x.data() + i, y.data() + j);
+      bloc(x.data() + i, y.data() + j);
+    }
+    si(i < n)
+    {
+      memcpy(entrée.data() + nb_entrée, x.data() + i, (n - i) * sizeof(T));
+      nb_entrée += n - i;
+    }
+    assertion(j == m);
+  }
+};
+
+}
+
+namespace tsd::filtrage {
+
+template<typename T>
+sptr<FiltreGen<T>> filtre_rif_partition(const Vecf &h, entier dim_partition, bouléen non_uniforme)
+{
+  retourne make_shared<tsd::fourier::FiltreRIFPartitions<T>>(h, dim_partition, non_uniforme);
+}
+
+template
+sptr<FiltreGen<float>> filtre_rif_partition<float>(const Vecf &h, entier dim_partition, bouléen non_uniforme);
+
+template
+sptr<FiltreGen<cfloat>> filtre_rif_partition<cfloat>(const Vecf &h, entier dim_partition, bouléen non_uniforme);
+
+}
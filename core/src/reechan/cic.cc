@@ -1,6 +1,7 @@
 // implémentation filtre CIC.
 
 #include "tsd/filtrage.hpp"
+#include <type_traits>
 
 using namespace std;
 using namespace tsd::vue;
@@ -9,14 +10,32 @@ using namespace tsd::vue;
 namespace tsd::filtrage {
 
 
+/** @brief Filtre CIC au fil de l'eau (décimation ou interpolation)
+ *
+ *  Les registres des intégrateurs et des peignes sont conservés d'un appel à l'autre,
+ *  et tous les étages sont calculés en une seule passe sur les échantillons
+ *  (pour N <= 6, le nombre d'étages est connu à la compilation et les intégrateurs restent dans les registres).
+ *
+ *  Les calculs se font en arithmétique modulaire (entiers non signés de même dimension que Ti) :
+ *  d'après Hogenauer, les débordements des intégrateurs sont sans conséquence sur la sortie,
+ *  tant que Ti compte au moins @f$N \log_2(RM) + B_{in}@f$ bits. */
 template<typename T, typename Ti>
 struct FiltreCIC: FiltreGen<T>
 {
+  // Arithmétique modulaire (pas de débordement signé)
+  using Tu = std::make_unsigned_t<Ti>;
+
   CICConfig config;
   char mode; // 'd' ou 'i'
-  Vecteur<Ti> mem_diff;
   float gain = 1;
 
+  // Intégrateurs, et lignes à retard des peignes (M valeurs par étage, circulaires)
+  vector<Tu> intégrateurs, peignes;
+  // Décimation : phase de l'échantillon d'entrée suivant (sortie si 0)
+  entier phase = 0;
+  // Position courante dans les lignes à retard des peignes
+  entier phase_peignes = 0;
+
   FiltreCIC(const CICConfig &config, char mode = 'd')
   {
     this->config  = config;
@@ -24,9 +43,10 @@ struct FiltreCIC: FiltreGen<T>
 
     si((mode != 'd') && (mode != 'u') && (mode != 'i'))
       échec("cic_init: le mode doit être 'd' ou 'i'.");
-    si(config.M != 1)
-      échec("cic_init: seulement M = 1 est supporté pour l'instant.");
-    mem_diff.setZero(config.N);
+    si((config.R <= 0) || (config.N <= 0) || (config.M <= 0))
+      échec("cic_init: paramètres invalides (R={}, N={}, M={}).", config.R, config.N, config.M);
+    intégrateurs.assign(config.N, 0);
+    peignes.assign(config.N * config.M, 0);
     soit RM = config.R*config.M, N = config.N;
     si(mode == 'd')
       gain = 1.0f / pow(RM,N);
@@ -34,67 +54,138 @@ struct FiltreCIC: FiltreGen<T>
       gain = ((float) config.R) / pow(RM, N);
   }
 
+  entier dim_sortie_max(entier n) const
+  {
+    si(mode == 'd')
+      retourne (n + config.R - 1) / config.R;
+    retourne n * config.R;
+  }
+
+  // Peignes (rythme lent) : v[n] - v[n-M], pour chaque étage
+  Tu peignes_step(Tu v)
+  {
+    soit M = config.M;
+    pour(auto k = 0; k < config.N; k++)
+    {
+      soit &p = peignes[k * M + phase_peignes];
+      soit d = v - p;
+      p = v;
+      v = d;
+    }
+    si(M > 1)
+      phase_peignes = (phase_peignes + 1) % M;
+    retourne v;
+  }
+
+  // Appel de f.operator()<NS>(), avec NS = N si N <= 6, 0 sinon
+  template<typename F>
+  void selon_nb_étages(F &&f)
+  {
+    switch(config.N)
+    {
+      case 1:  f.template operator()<1>(); break;
+      case 2:  f.template operator()<2>(); break;
+      case 3:  f.template operator()<3>(); break;
+      case 4:  f.template operator()<4>(); break;
+      case 5:  f.template operator()<5>(); break;
+      case 6:  f.template operator()<6>(); break;
+      default: f.template operator()<0>();
+    }
+  }
+
   void step(const Vecteur<T> &x, Vecteur<T> &y)
   {
-    // Conversion évenutuelle en virgule fixe (entiers)
-    soit xi = x.template as<Ti>();
-    soit N = config.N, R = config.R;
+    si(x.data() == y.data())
+    {
+      Vecteur<T> x2 = x.clone();
+      retourne step(x2, y);
+    }
+
+    soit n = x.rows(), R = config.R;
 
     ////////////////////////////////////
     /// DECIMATION  ////////////////////
     ////////////////////////////////////
     si(mode == 'd')
     {
-      // (1) Integration
-      pour(auto i = 0; i < N; i++)
-        xi = cumsum(xi);
-
-      // (2) Decimation
-      soit xd = sousech(xi, R);
-
-      // (3) Peignes
-      pour(auto i = 0; i < N; i++)
+      // Sorties pour les échantillons d'entrée de phase nulle
+      soit p0 = (R - phase) % R;
+      soit m  = (n > p0) ? (n - p0 - 1) / R + 1 : 0;
+      y.resize(m);
+      selon_nb_étages([&]<entier NS>()
       {
-        soit n = xd.rows();
-        Vecteur<Ti> xp(n + 1);
-        xp(0) = mem_diff(i);
-        xp.segment(1, n) = xd;
-        mem_diff(i) = xd(n-1);
-        xd = diff(xp);
-      }
-      y = xd.template as<float>() * gain;
+        soit N = (NS > 0) ? NS : config.N;
+        Tu s[NS > 0 ? NS : 1];
+        Tu *in = (NS > 0) ? s : intégrateurs.data();
+        si constexpr(NS > 0)
+          pour(auto k = 0; k < NS; k++)
+            s[k] = intégrateurs[k];
+
+        soit xptr = x.data();
+        soit optr = y.data();
+        soit intègre = [&](entier i0, entier i1)
+        {
+          pour(auto i = i0; i < i1; i++)
+          {
+            Tu v = (Tu) (Ti) xptr[i];
+            pour(auto k = 0; k < N; k++)
+            {
+              in[k] += v;
+              v = in[k];
+            }
+          }
+        };
+
+        intègre(0, min(n, p0));
+        pour(auto i = p0; i < n; i += R)
+        {
+          intègre(i, i + 1);
+          *optr++ = (T) ((float) (Ti) peignes_step(in[N - 1]) * gain);
+          intègre(i + 1, min(n, i + R));
+        }
+        phase = (phase + n) % R;
+
+        si constexpr(NS > 0)
+          pour(auto k = 0; k < NS; k++)
+            intégrateurs[k] = s[k];
+      });
       retourne;
     }
 
     ////////////////////////////////////
     /// INTERPOLATION  /////////////////
     ////////////////////////////////////
-    // (1) Peignes
-    pour(auto i = 0; i < N; i++)
+    // Pour chaque échantillon d'entrée : peignes, puis R échantillons intégrés (insertion de zéros)
+    y.resize(n * R);
+    selon_nb_étages([&]<entier NS>()
     {
-      soit n = xi.rows();
-      Vecteur<Ti> xp(n + 1);
-      xp(0) = mem_diff(i);
-      xp.segment(1,n) = xi;
-      mem_diff(i) = x(n-1);
-      xi = diff(xp);
-    }
-
-
-    // (2) Upsampling (insertion de zéros)
-    soit n = xi.rows();
-    soit tmp = Vecteur<Ti>::zeros(n * R);
-
-    pour(auto i = 0; i < n; i++)
-      tmp(i * R) = xi(i);
-
-    xi = tmp;
-
-    // (3) Integration
-    pour(auto i = 0; i < N; i++)
-      xi = cumsum(xi);
+      soit N = (NS > 0) ? NS : config.N;
+      Tu s[NS > 0 ? NS : 1];
+      Tu *in = (NS > 0) ? s : intégrateurs.data();
+      si constexpr(NS > 0)
+        pour(auto k = 0; k < NS; k++)
+          s[k] = intégrateurs[k];
+
+      soit optr = y.data();
+      pour(auto i = 0; i < n; i++)
+      {
+        Tu v = peignes_step((Tu) (Ti) x(i));
+        pour(auto r = 0; r < R; r++)
+        {
+          pour(auto k = 0; k < N; k++)
+          {
+            in[k] += v;
+            v = in[k];
+          }
+          *optr++ = (T) ((float) (Ti) v * gain);
+          v = 0;
+        }
+      }
 
-    y = xi.template as<float>() * gain;
+      si constexpr(NS > 0)
+        pour(auto k = 0; k < NS; k++)
+          intégrateurs[k] = s[k];
+    });
   }
 };
 
@@ -318,6 +409,7 @@ CICComp design_cic_comp(const CICConfig &config, float fe, entier R2, float fc,
 
 namespace hidden {
 soit filtre_cic1 = filtre_cic<float, entier>;
+soit filtre_cic2 = filtre_cic<float, int64_t>;
 }
 
 
@@ -89,8 +89,65 @@ namespace tsd::filtrage
     retourne h;
   }
 
+  vector<Vecf> design_rif_demi_bande_cascade(entier k, float fc, float atten_db)
+  {
+    si(k < 1)
+      échec("design_rif_demi_bande_cascade : nombre d'étages invalide ({}).", k);
+    si((fc <= 0) || (fc >= 0.5))
+      échec("design_rif_demi_bande_cascade : fréquence de coupure invalide ({}, doit être comprise entre 0 et 0,5).", fc);
 
-
-
+    vector<Vecf> res(k);
+    pour(auto s = 0; s < k; s++)
+    {
+      // Bande utile [0, fp] à la fréquence d'échantillonnage de l'étage (la plus élevée des deux),
+      // bande de transition [fp, 1/2 - fp] : seules les composantes qui se replient sur [0, fp] doivent être atténuées.
+      soit fp = fc / (1 << (k - s));
+      soit Δ  = 0.5f - 2 * fp;
+
+      // Atténuation obtenue pour n = 4P - 1 coefficients
+      soit essai = [&](entier P)
+      {
+        soit h = design_rif_demi_bande(4 * P - 1, fp);
+        soit [fr, mag] = frmag(h, 2048);
+        soit mx = 0.0f;
+        pour(auto i = 0; i < fr.rows(); i++)
+          si(fr(i) >= 0.5f - fp)
+            mx = max(mx, mag(i));
+        retourne std::tuple<Vecf, float>{h, -20 * log10(max(mx, 1e-12f))};
+      };
+
+      // Estimation (formule de Kaiser), puis nombre minimal de coefficients
+      soit n0 = (entier) ceil((atten_db - 7.95f) / (14.36f * Δ)) + 1;
+      soit P  = max((entier) 1, (n0 + 4) / 4);
+      Vecf h;
+      float att;
+      std::tie(h, att) = essai(P);
+      si(att >= atten_db)
+      {
+        tantque(P > 1)
+        {
+          Vecf h2;
+          float att2;
+          std::tie(h2, att2) = essai(P - 1);
+          si(att2 < atten_db)
+            break;
+          h = h2;
+          P--;
+        }
+      }
+      sinon
+      {
+        tantque(att < atten_db)
+        {
+          si(P >= 256)
+            échec("design_rif_demi_bande_cascade : atténuation de {} dB non atteinte (étage {}, fp = {}).", atten_db, s, fp);
+          P++;
+          std::tie(h, att) = essai(P);
+        }
+      }
+      res[s] = h;
+    }
+    retourne res;
+  }
 
 }
@@ -1,41 +1,57 @@
 #include "tsd/filtrage/spline.hpp"
 #include "tsd/filtrage.hpp"
 #include "tsd/divers.hpp"
+#include <cstring>
 
 using namespace std;
 
 namespace tsd::filtrage {
 
 
+// Sinus cardinal fenêtré, retard nc/2 + τ
+static Vecf itrp_sinc_coefs(entier nc, float fcut, cstring fenetre, float τ)
+{
+  soit h = Vecf::int_expr(nc, [&](entier i){retourne sinc(2 * fcut, i-nc/2-τ);});
+
+  // Fenêtre de Hann, décalée d'un retard fractionnaire -τ
+  si(fenetre == "hn")
+  {
+    soit a  = 0.5f, b = 0.25f;
+    soit t  = (linspace(-nc/2,(nc-1)/2,nc) - τ) * (2*π/nc),
+         r1 = cos(t),
+         r2 = a + 2 * b * r1;
+    h *= r2;
+  }
+  retourne h;
+}
+
 template<typename T>
 struct InterpolateurSinc: InterpolateurRIF<T>
 {
   InterpolateurSincConfig config;
   Tabf lut;
 
-  Vecf coefs(float τ)
+  entier lut_index(float τ) const
   {
     assertion_msg((τ >= 0) && (τ <= 1), "InterpolateurSinc::coefs(τ={}) : délais invalide.", τ);
-    entier lut_index = τ * config.nphases;
-    assertion((lut_index >= 0) && (lut_index <= config.nphases));
-    retourne lut.col(lut_index);
+    entier i = τ * config.nphases;
+    assertion((i >= 0) && (i <= config.nphases));
+    retourne i;
   }
 
-  Vecf coefs_calcule(float τ)
+  Vecf coefs(float τ)
   {
-    soit nc = config.ncoefs;
-    soit h = Vecf::int_expr(nc, [&](entier i){retourne sinc(2 * config.fcut, i-nc/2-τ);});
+    retourne lut.col(lut_index(τ));
+  }
 
-    // Fenêtre de Hann, décalée d'un retard fractionnaire -τ
-    si(config.fenetre == "hn")
-    {
-      soit a  = 0.5f, b = 0.25f;
-      soit t  = (linspace(-nc/2,(nc-1)/2,nc) - τ) * (2*π/nc),
-           r1 = cos(t),
-           r2 = a + 2 * b * r1;
-      h *= r2;
-    }
-    retourne h;
+  void coefs_into(float τ, float *h)
+  {
+    memcpy(h, lut.data() + lut_index(τ) * this->K, this->K * sizeof(float));
+  }
+
+  Vecf coefs_calcule(float τ)
+  {
+    retourne itrp_sinc_coefs(config.ncoefs, config.fcut, config.fenetre, τ);
   }
 
   InterpolateurSinc(const InterpolateurSincConfig &config)
@@ -60,11 +76,21 @@ struct InterpolateurCSpline: InterpolateurRIF<T>
 {
   Tabf lut;
 
+  entier lut_index(float τ) const
+  {
+    soit i = (entier) (τ * 256);
+    assertion((i >= 0) && (i <= 256));
+    retourne i;
+  }
+
   Vecf coefs(float τ)
   {
-    soit lut_index = (entier) (τ * 256);
-    assertion((lut_index >= 0) && (lut_index <= 256));
-    retourne lut.col(lut_index);
+    retourne lut.col(lut_index(τ));
+  }
+
+  void coefs_into(float τ, float *h)
+  {
+    memcpy(h, lut.data() + lut_index(τ) * 4, 4 * sizeof(float));
   }
 
   /** @param c Tension parameter (0 : Catmull-Rom spline)
@@ -86,6 +112,12 @@ struct InterpolateurLineaire: InterpolateurRIF<T>
     retourne Vecf::valeurs({1-τ, τ});
   }
 
+  void coefs_into(float τ, float *h)
+  {
+    h[0] = 1 - τ;
+    h[1] = τ;
+  }
+
   InterpolateurLineaire()
   {
     this->nom     = "linéaire";
@@ -112,7 +144,12 @@ struct InterpolateurLagrange: InterpolateurRIF<T>
   Vecf coefs(float τ)
   {
     Vecf h(d+1);
+    coefs_into(τ, h.data());
+    retourne h;
+  }
 
+  void coefs_into(float τ, float *h)
+  {
     // Points: 0 1 2 ... d
     // interpole à (d-1)/2 + mu
     // Exemple: d = 1
@@ -125,10 +162,80 @@ struct InterpolateurLagrange: InterpolateurRIF<T>
       pour(auto k = 0; k <= d; k++)
         si(k != j)
           p *= (t - k) / (j - k);
-      h(j) = p;
+      h[j] = p;
+    }
+  }
+};
+
+/** Structure de Farrow : coefficient k = polynôme de degré D en u = τ - 1/2,
+ *  approchant (moindres carrés) le sinus cardinal fenêtré de itrp_sinc(). */
+template<typename T>
+struct InterpolateurFarrow: InterpolateurRIF<T>
+{
+  InterpolateurFarrowConfig config;
+  entier D = 0;
+  // poly(k, d) : coefficient de u^d pour le coefficient k (une colonne contiguë par degré)
+  Tabf poly;
+
+  InterpolateurFarrow(const InterpolateurFarrowConfig &config)
+  {
+    this->config  = config;
+    this->nom     = format("Farrow - ncoefs={}, degré={}, fcut={}, fen={}",
+                           config.ncoefs, config.degré, config.fcut, config.fenetre);
+    this->K       = config.ncoefs;
+    this->delais  = 0.5 * this->K;
+    D             = config.degré;
+
+    verifie_frequence_normalisee(config.fcut, "interpolateur de Farrow");
+    si((this->K <= 0) || (D < 0) || (D > 9))
+      échec("itrp_farrow : configuration invalide (ncoefs = {}, degré = {}).", this->K, D);
+
+    // Moindres carrés sur une grille de retards, en double précision
+    soit G = 16 * (D + 1), K = this->K;
+    Tabd A(G, D + 1);
+    Tabf hg(K, G);
+    pour(auto g = 0; g < G; g++)
+    {
+      soit τ = ((double) g) / (G - 1);
+      soit u = 1.0;
+      pour(auto d = 0; d <= D; d++, u *= τ - 0.5)
+        A(g, d) = u;
+      hg.col(g) = itrp_sinc_coefs(K, config.fcut, config.fenetre, τ);
     }
+    poly.resize(K, D + 1);
+    pour(auto k = 0; k < K; k++)
+    {
+      Vecd b(G);
+      pour(auto g = 0; g < G; g++)
+        b(g) = hg(k, g);
+      Vecd c = A.lsq(b);
+      pour(auto d = 0; d <= D; d++)
+        poly(k, d) = c(d);
+    }
+  }
+
+  Vecf coefs(float τ)
+  {
+    Vecf h(this->K);
+    coefs_into(τ, h.data());
     retourne h;
   }
+
+  // Horner, tous les coefficients à la fois (boucles vectorisées sur k)
+  void coefs_into(float τ, float *h)
+  {
+    horner(poly.data(), τ - 0.5f, h);
+  }
+
+  void horner(const float * __restrict p, float u, float * __restrict h) const
+  {
+    soit K = this->K;
+    pour(auto k = 0; k < K; k++)
+      h[k] = p[D * K + k];
+    pour(auto d = D - 1; d >= 0; d--)
+      pour(auto k = 0; k < K; k++)
+        h[k] = h[k] * u + p[d * K + k];
+  }
 };
 
 
@@ -156,6 +263,12 @@ sptr<InterpolateurRIF<T>> itrp_sinc(const InterpolateurSincConfig &config)
   retourne make_shared<InterpolateurSinc<T>>(config);
 }
 
+template<typename T>
+sptr<InterpolateurRIF<T>> itrp_farrow(const InterpolateurFarrowConfig &config)
+{
+  retourne make_shared<InterpolateurFarrow<T>>(config);
+}
+
 
 
 // Interpolation linéaire, points non équidistants
@@ -335,6 +448,8 @@ soit itrp_lineaire_float = itrp_lineaire<float>;
 soit itrp_lineaire_cfloat = itrp_lineaire<cfloat>;
 soit itrp_sinc_float = itrp_sinc<float>;
 soit itrp_sinc_cfloat = itrp_sinc<cfloat>;
+soit itrp_farrow_float = itrp_farrow<float>;
+soit itrp_farrow_cfloat = itrp_farrow<cfloat>;
 
 }
 
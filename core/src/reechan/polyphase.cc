@@ -5,6 +5,7 @@
 #include "tsd/tsd.hpp"
 #include "tsd/filtrage.hpp"
 #include "tsd/vue.hpp"
+#include <cstring>
 
 using namespace std;
 using namespace tsd::vue;
@@ -50,190 +51,385 @@ Vecteur<T> iforme_polyphase(const TabT<T,2> &x)
 
 
 
-// Implémentation optimisée pour filtre demi-bande
-template<typename T, typename Tc>
-struct FiltreRIFDemiBande: FiltreGen<T>
+// Filtre demi-bande : coefficient central h_c, et coefficients non nuls à une distance impaire
+// du centre uniquement, symétriques : g_p = h_{c - 2p - 1} = h_{c + 2p + 1}, p < P.
+// Les coefficients à une distance paire du centre (nuls) ne sont jamais utilisés.
+struct DemiBandeCoefs
 {
-  Vecteur<T> fenêtre;
-  Vecteur<Tc> coefs;
-  entier index = 0, K = 0,
-         odd = 0, R = 2;
+  entier K = 0, c = 0, P = 0;
+  float centre = 0.5f;
+  // g_{P-1-q}, q < P (ordre inverse, noyau rif_bloc_replié())
+  Vecf hr;
+};
 
-  FiltreRIFDemiBande(const Vecteur<Tc> &c)
+template<typename Tc>
+static DemiBandeCoefs demi_bande_coefs(const Vecteur<Tc> &h)
+{
+  DemiBandeCoefs d;
+  d.K = h.rows();
+  si((d.K < 3) || est_pair(d.K))
+    échec("Filtre demi-bande : nombre de coefficients invalide ({}, doit être impair, et au moins 3).", d.K);
+  d.c      = (d.K - 1) / 2;
+  d.centre = h(d.c);
+
+  // Tolérance : design par fenêtrage (coefficients nuls aux erreurs d'arrondi près)
+  soit tol = 1e-6f * abs(h).valeur_max();
+  pour(auto δ = 1; δ <= d.c; δ++)
   {
-    coefs   = c;
-    K       = coefs.rows();
-    fenêtre = Vecteur<T>::zeros(K);
+    si(abs(h(d.c - δ) - h(d.c + δ)) > tol)
+      échec("Filtre demi-bande : coefficients non symétriques.");
+    si(est_pair(δ) && (abs(h(d.c - δ)) > tol))
+      échec("Filtre demi-bande : coefficient non nul à une distance paire du centre ({} = {}).", d.c - δ, h(d.c - δ));
   }
 
-  void step(const Vecteur<T> &x, Vecteur<T> &y)
-  {
-    assertion(K > 0);
-    soit n    = x.rows();
-    soit iptr = x.data();
-    soit optr = y.data();
-    si(iptr != optr)
-    {
-      y.resize((n + odd) / R);
-      optr = y.data();
-    }
-
-    pour(auto j = 0; j < n; j++)
-    {
-      soit cptr = coefs.data();
-
-      T somme = 0;
+  // Coefficients extrêmes nuls (fenêtre, ou design complété par des zéros) : ignorés
+  d.P = (d.c + 1) / 2;
+  tantque((d.P > 0) && (abs(h(d.c - 2 * d.P + 1)) <= tol))
+    d.P--;
+  si(d.P == 0)
+    échec("Filtre demi-bande : tous les coefficients sont nuls, hormis le coefficient central.");
 
-      // La moitié des coefficients sont nuls.
-      // .... x3 x2 x1 x0
-      // -> y0 = x0 * h0 + x2 * h1 + ...
-      // -> y1 = x2 * h0 + ?
+  d.hr.resize(d.P);
+  pour(auto q = 0; q < d.P; q++)
+  {
+    soit δ = 2 * (d.P - 1 - q) + 1;
+    d.hr(q) = 0.5f * (h(d.c - δ) + h(d.c + δ));
+  }
+  retourne d;
+}
 
-      // Donc on n'utilise que le signal pair ?
-      // xpair   -> H0
-      // ximpair -> H1 (nul)
+// Décimation d'un facteur 2 par un filtre demi-bande.
+//
+// Même convention que filtre_rif_decim() (R = 2) : y_j = somme_k h_k e[t0 + 2j + k],
+// avec e = [K - 1 derniers échantillons, bloc d'entrée]. En notant u = t0 + c - (2P - 1)
+// et a_i = e[u + 2i] (branche des coefficients non nuls) :
+//   y_j = h_c e[t0 + c + 2j] + somme_q g_{P-1-q} (a_{j+q} + a_{j+2P-1-q}),
+// soit P multiplications (noyau RIF replié) et une pour le coefficient central, par sortie.
+template<typename T, typename Tc>
+struct FiltreRIFDemiBande: FiltreGen<T>
+{
+  static constexpr entier S = est_complexe<T>() ? 2 : 1;
 
-      // Attention, 3 coefficients centrals non nuls puis zéros réguliérement.
-      // Disons filtre de type h0 0 h1 0 h2
-      //
+  DemiBandeCoefs hb;
+  // Parité (nombre d'échantillons d'entrée en attente d'une sortie)
+  entier cnt = 0;
+  Vecteur<T> historique, ext, a;
 
-      // Remplace les deux plus ancien éléments
-      fenêtre(index) = *iptr++;
-      index = (index + 1) % K;
+  FiltreRIFDemiBande(const Vecteur<Tc> &c)
+  {
+    hb = demi_bande_coefs(c);
+    historique.setZero(hb.K - 1);
+  }
 
-      // Ne calcule qu'un échantillon sur R
-      si(odd < R - 1)
-      {
-        odd++;
-        continue;
-      }
-      odd = 0;
+  entier dim_sortie_max(entier n) const
+  {
+    retourne (n + 1) / 2;
+  }
 
-      soit wptr = fenêtre.data() + index;
+  void step(const Vecteur<T> &x, Vecteur<T> &y)
+  {
+    soit n = x.rows(), K = hb.K, P = hb.P;
+    soit m  = (n + cnt) / 2,
+         t0 = 1 - cnt;
+
+    ext.resize(K - 1 + n);
+    memcpy(ext.data(), historique.data(), (K - 1) * sizeof(T));
+    memcpy(ext.data() + K - 1, x.data(), n * sizeof(T));
+    cnt = (cnt + n) % 2;
+    memcpy(historique.data(), ext.data() + n, (K - 1) * sizeof(T));
+
+    // (x peut être y : déjà recopié)
+    y.resize(m);
+    si(m == 0)
+      retourne;
+
+    soit e = ext.data();
+    soit u = t0 + hb.c - (2 * P - 1);
+    soit L = m + 2 * P - 1;
+    a.resize(L);
+    soit ap = a.data();
+    pour(auto i = 0; i < L; i++)
+      ap[i] = e[u + 2 * i];
+
+    soit yp = y.data();
+    soit ec = e + t0 + hb.c;
+    pour(auto j = 0; j < m; j++)
+      yp[j] = hb.centre * ec[2 * j];
+
+    rif_bloc_replié(hb.hr.data(), P, (const float *) ap, (const float *) (ap + 2 * P - 1),
+                    (float *) yp, S * m, S, non);
+  }
+};
 
-      // Nombre d'échantillons à la fin de la ligne à retard
-      soit K1 = K - index,
-      // Nombre d'échantillons au début de la ligne à retard
-           K2 = K - K1;
+// Interpolation d'un facteur 2 par un filtre demi-bande (gain 2, pour préserver l'amplitude) :
+// y_t = somme_k 2 h_k x'_{t-k}, x' étant le signal d'entrée avec un zéro inséré après chaque échantillon.
+//
+// Pour chaque échantillon d'entrée x_n, deux sorties :
+//  - phase r0 = c mod 2 : retard pur, y_{2n+r0} = 2 h_c x_{n - (c - r0)/2},
+//  - phase r1 = 1 - r0  : filtre replié, y_{2n+r1} = somme_p 2 g_p (x_{n+δ-p} + x_{n+δ+p+1}), δ = (r1 - c - 1) / 2.
+template<typename T, typename Tc>
+struct FiltreRIFDemiBandeUps: FiltreGen<T>
+{
+  static constexpr entier S = est_complexe<T>() ? 2 : 1;
 
-      entier i;
-      pour(i = 0; i < K1; i += 2) // 1 coefficient sur 2 du filtre est nul
-      {
-        somme += *wptr * *cptr;
-        wptr  += 2;
-        cptr  += 2;
-      }
+  DemiBandeCoefs hb;
+  // Coefficients repliés, multipliés par 2
+  Vecf hr2;
+  // c derniers échantillons d'entrée
+  Vecteur<T> historique, ext, yr;
 
-      i = i - K1;
+  FiltreRIFDemiBandeUps(const Vecteur<Tc> &c)
+  {
+    hb  = demi_bande_coefs(c);
+    hr2 = 2 * hb.hr;
+    historique.setZero(hb.c);
+  }
 
-      // Redémarre au début de la ligne à retard
-      wptr = fenêtre.data() + i;
-      pour(; i < K2; i += 2)
-      {
-        somme += *wptr * *cptr;
-        wptr  += 2;
-        cptr  += 2;
-      }
+  entier dim_sortie_max(entier n) const
+  {
+    retourne 2 * n;
+  }
 
-      // Coefficient central non nul = 0.5 (forcément)
-      somme += /*coefs(K/2)*/ 0.5f * fenêtre((index + K/2) % K);
+  void step(const Vecteur<T> &x, Vecteur<T> &y)
+  {
+    soit n = x.rows(), c = hb.c, P = hb.P;
+
+    ext.resize(c + n);
+    memcpy(ext.data(), historique.data(), c * sizeof(T));
+    memcpy(ext.data() + c, x.data(), n * sizeof(T));
+    memcpy(historique.data(), ext.data() + n, c * sizeof(T));
+
+    y.resize(2 * n);
+    si(n == 0)
+      retourne;
+
+    soit r0 = c % 2, r1 = 1 - r0;
+    soit δ  = (r1 - c - 1) / 2;
+    soit e  = ext.data();
+
+    // Phase filtrée
+    yr.resize(n);
+    memset((void *) yr.data(), 0, n * sizeof(T));
+    rif_bloc_replié(hr2.data(), P, (const float *) (e + c + δ - (P - 1)), (const float *) (e + c + δ + P),
+                    (float *) yr.data(), S * n, S, non);
+
+    // Entrelacement avec la phase retardée
+    soit yp = y.data(), rp = yr.data();
+    soit ed = e + c - (c - r0) / 2;
+    soit g  = 2 * hb.centre;
+    pour(auto i = 0; i < n; i++)
+    {
+      yp[2 * i + r0] = g * ed[i];
+      yp[2 * i + r1] = rp[i];
+    }
+  }
+};
 
+// Cascade de filtres (sortie de chaque étage = entrée du suivant)
+template<typename T>
+struct FiltreCascade: FiltreGen<T>
+{
+  vector<sptr<FiltreGen<T>>> étages;
+  Vecteur<T> tampons[2];
 
-      /*  pour i = 0; i < N; i += R
-       * (fenêtre(index + i [N]) + fenêtre(index - 1 - i [N])) * coefs(i)
-       */
+  entier dim_sortie_max(entier n) const
+  {
+    pour(auto &e: étages)
+      n = e->dim_sortie_max(n);
+    retourne n;
+  }
 
-      *optr++ = somme;
+  void step(const Vecteur<T> &x, Vecteur<T> &y)
+  {
+    soit ne = (entier) étages.size();
+    si(ne == 0)
+    {
+      y = x;
+      retourne;
+    }
+    const Vecteur<T> *src = &x;
+    pour(auto i = 0; i + 1 < ne; i++)
+    {
+      étages[i]->step(*src, tampons[i % 2]);
+      src = &tampons[i % 2];
     }
+    étages[ne - 1]->step(*src, y);
   }
 };
 
+template<typename T>
+sptr<FiltreGen<T>> filtre_rif_demi_bande_cascade(entier k, float fc, float atten_db, bouléen interpolation)
+{
+  soit designs = design_rif_demi_bande_cascade(k, fc, atten_db);
+  soit f = make_shared<FiltreCascade<T>>();
+  pour(auto s = 0; s < k; s++)
+  {
+    si(interpolation)
+      f->étages.push_back(make_shared<FiltreRIFDemiBandeUps<T, float>>(designs[k - 1 - s]));
+    sinon
+      f->étages.push_back(make_shared<FiltreRIFDemiBande<T, float>>(designs[s]));
+  }
+  retourne f;
+}
+
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Filtre RIF avec décimation 1:R (suppose qu'un échantillon sur R est nul) ///
+// Filtre RIF avec décimation 1:R (seuls les échantillons conservés sont calculés)
 ///////////////////////////////////////////////////////////////////////////////
+//
+// Sortie j : y_j = somme_i h_i x_{t_j - K + 1 + i}, où t_j est l'indice du
+// R-ième échantillon d'entrée.
+//
+// Traitement par bloc (décomposition polyphase) : en notant i = R.q + r,
+//   y_j = somme_r somme_q h_r[q] x_r[j + q],
+// avec h_r[q] = h[R.q + r] et x_r[p] = e[t0 + r + R.p] (e = historique + bloc d'entrée).
+// Chaque branche est un filtre RIF classique (noyau rif_bloc()).
+//
+// Si h est symétrique (ou anti-symétrique), h_r[q] = ± h_r'[Q_r - 1 - q],
+// avec r' = (B - r) mod R, K - 1 = R.A + B : les branches r et r' sont traitées
+// ensemble par le noyau replié (pré-addition de x_r et x_r'), soit deux fois moins
+// de multiplications.
 template<typename T, typename Tc>
 struct FiltreRIFDecim: FiltreGen<T>
 {
-  Vecteur<T> fenêtre;
-  Vecteur<Tc> coefs;
-  entier index = 0, K = 0,
-         cnt   = 0, R = 0;
+  // Types supportés par les noyaux par bloc
+  static constexpr bouléen avec_bloc =
+      std::is_same_v<Tc, float> && (std::is_same_v<T, float> || std::is_same_v<T, cfloat>);
+  static constexpr entier S = std::is_same_v<T, cfloat> ? 2 : 1;
+
+  // En dessous (nombre de sorties), calcul direct
+  static const entier DIM_BLOC_MIN = 8;
+
+  Vecteur<Tc> coefs, coefs_repliés;
+  entier K = 0, cnt = 0, R = 0, symétrie = 0;
+  // K-1 derniers échantillons d'entrée
+  Vecteur<T> historique;
+
+  // Par branche : coefficients (éventuellement repliés), branche associée (symétrie)
+  struct Branche
+  {
+    Vecf h;
+    entier Q = 0, partenaire = 0;
+  };
+  vector<Branche> branches;
+
+  // Historique + bloc d'entrée, et branches (x_r) désentrelacées
+  Vecteur<T> ext, xr;
 
   FiltreRIFDecim(const Vecteur<Tc> &c, entier R)
   {
     this->R = R;
     coefs   = c;
     K       = coefs.rows();
-    fenêtre = Vecteur<T>::zeros(K);
+    historique.setZero(max(K - 1, (entier) 0));
+
+    si(K >= 4)
+      symétrie = rif_symétrie(coefs);
+    si(symétrie != 0)
+      coefs_repliés = rif_coefs_repliés(coefs, symétrie);
+
+    si constexpr(avec_bloc)
+    {
+      branches.resize(R);
+      soit B = (K - 1) % R;
+      pour(auto r = 0; r < R; r++)
+      {
+        soit &b = branches[r];
+        b.Q = (r < K) ? (K - 1 - r) / R + 1 : 0;
+        b.partenaire = r;
+        b.h.resize(b.Q);
+        pour(auto q = 0; q < b.Q; q++)
+          b.h(q) = coefs(R * q + r);
+        si(symétrie != 0)
+        {
+          b.partenaire = (B - r + R) % R;
+          // Branche repliée sur elle-même : filtre à phase linéaire
+          si(b.partenaire == r)
+            b.h = rif_coefs_repliés(b.h, symétrie);
+        }
+      }
+    }
+  }
+
+  entier dim_sortie_max(entier n) const
+  {
+    retourne (n + R - 1) / R;
+  }
+
+  // somme_i h_i w_i
+  T produit(const T *w) const
+  {
+    si(symétrie != 0)
+      retourne rif_produit_replié(coefs_repliés.data(), w, K, symétrie);
+    T somme = 0;
+    pour(auto i = 0; i < K; i++)
+      somme += w[i] * coefs(i);
+    retourne somme;
   }
 
   void step(const Vecteur<T> &x, Vecteur<T> &y)
   {
     assertion(K > 0);
     soit n = x.rows();
-    soit iptr = x.data();
-    soit optr = y.data();
-    si(iptr != optr)
-    {
-      y.resize((n + cnt) / R);
-      optr = y.data();
-    }
+    // Nombre de sorties, et position de la première dans le bloc
+    soit m  = (n + cnt) / R,
+         t0 = R - 1 - cnt;
 
-    pour(auto j = 0; j < n; j++)
-    {
-      soit cptr = coefs.data();
+    // ext = [K-1 derniers échantillons, x]
+    ext.resize(K - 1 + n);
+    memcpy(ext.data(), historique.data(), (K - 1) * sizeof(T));
+    memcpy(ext.data() + K - 1, x.data(), n * sizeof(T));
 
-      T somme = 0;
+    si(x.data() != y.data())
+      y.resize(m);
+    soit optr = y.data();
 
-      // La moitié des coefficients sont nuls.
-      // .... x3 x2 x1 x0
-      // -> y0 = x0 * h0 + x2 * h1 + ...
-      // -> y1 = x2 * h0 + ?
+    bouléen par_bloc = non;
+    si constexpr(avec_bloc)
+      par_bloc = (m >= DIM_BLOC_MIN);
 
-      // Donc on n'utilise que le signal pair ?
-      // xpair   -> H0
-      // ximpair -> H1 (nul)
+    si(par_bloc)
+      step_bloc(optr, m, t0);
+    sinon
+    {
+      pour(auto j = 0; j < m; j++)
+        optr[j] = produit(ext.data() + t0 + R * j);
+    }
 
-      // Attention, 3 coefficients centrals non nuls puis zéros réguliérement.
-      // Disons filtre de type h0 0 h1 0 h2
-      //
+    cnt = (cnt + n) % R;
+    memcpy(historique.data(), ext.data() + n, (K - 1) * sizeof(T));
+  }
 
-      // Remplace les deux plus ancien éléments
-      fenêtre(index) = *iptr++;
-      index = (index + 1) % K;
+  void step_bloc(T *y, entier m, entier t0)
+  {
+    // Désentrelacement : x_r[p] = ext[t0 + r + R.p], p < m + Q_r - 1
+    soit L = m + (K - 1) / R;
+    xr.resize(R * L);
+    pour(auto r = 0; r < R; r++)
+    {
+      soit Lr = m + branches[r].Q - 1;
+      soit src = ext.data() + t0 + r;
+      soit dst = xr.data() + r * L;
+      pour(auto p = 0; p < Lr; p++)
+        dst[p] = src[R * p];
+    }
 
-      // Ne calcule qu'un échantillon sur R
-      si(cnt < R - 1)
-      {
-        cnt++;
+    soit o = (float *) y;
+    memset(o, 0, m * sizeof(T));
+    pour(auto r = 0; r < R; r++)
+    {
+      soit &b = branches[r];
+      si((b.Q == 0) || (b.partenaire < r))
         continue;
+      soit a = (const float *) (xr.data() + r * L);
+      si(symétrie == 0)
+        rif_bloc(b.h.data(), b.Q, a, o, S * m, S, oui);
+      sinon
+      {
+        soit bp = (const float *) (xr.data() + b.partenaire * L + b.Q - 1);
+        rif_bloc_replié(b.h.data(), b.h.rows(), a, bp, o, S * m, S, symétrie < 0);
       }
-      cnt = 0;
-
-
-      soit wptr = fenêtre.data() + index;
-
-      // Nombre d'échantillons à la fin de la ligne à retard
-      soit K1 = K - index,
-      // Nombre d'échantillons au début de la ligne à retard
-           K2 = K - K1;
-
-      pour(auto i = 0; i < K1; i++)
-        somme += *wptr++ * *cptr++;
-
-      // Redémarre au début de la ligne à retard
-      wptr = fenêtre.data();
-      pour(auto i = 0; i < K2; i++)
-        somme += *wptr++ * *cptr++;
-
-
-
-      /* pour i = 0; i < N; i += R
-       * (fenêtre(index + i [N]) + fenêtre(index - 1 - i [N])) * coefs(i) */
-
-      *optr++ = somme;
     }
   }
 };
@@ -274,6 +470,11 @@ struct FiltreRIFUps: FiltreGen<T>
 
   }
 
+  entier dim_sortie_max(entier n) const
+  {
+    retourne n * R;
+  }
+
   void step(const Vecteur<T> &x, Vecteur<T> &y)
   {
     assertion(K > 0);
@@ -353,6 +554,12 @@ sptr<FiltreGen<T>> filtre_rif_demi_bande(const Vecteur<Tc> &c)
   retourne make_shared<FiltreRIFDemiBande<T,Tc>>(c);
 }
 
+template<typename Tc, typename T>
+sptr<FiltreGen<T>> filtre_rif_demi_bande_ups(const Vecteur<Tc> &c)
+{
+  retourne make_shared<FiltreRIFDemiBandeUps<T,Tc>>(c);
+}
+
 template<typename Tc, typename T>
 sptr<FiltreGen<T>> filtre_rif_ups(const Vecteur<Tc> &c, entier R)
 {
@@ -380,6 +587,10 @@ soit filtre_rif_decim1 = filtre_rif_decim<float, float>;
 soit filtre_rif_decim2 = filtre_rif_decim<float, cfloat>;
 soit filtre_rif_demi_bande1 = filtre_rif_demi_bande<float, float>;
 soit filtre_rif_demi_bande2 = filtre_rif_demi_bande<float, cfloat>;
+soit filtre_rif_demi_bande_ups1 = filtre_rif_demi_bande_ups<float, float>;
+soit filtre_rif_demi_bande_ups2 = filtre_rif_demi_bande_ups<float, cfloat>;
+soit filtre_rif_demi_bande_cascade1 = filtre_rif_demi_bande_cascade<float>;
+soit filtre_rif_demi_bande_cascade2 = filtre_rif_demi_bande_cascade<cfloat>;
 soit filtre_rif_ups1 = filtre_rif_ups<float, float>;
 soit filtre_rif_ups2 = filtre_rif_ups<float, cfloat>;
 soit forme_polyphase1 = forme_polyphase<float>;
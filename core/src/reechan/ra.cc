@@ -1,5 +1,9 @@
 #include "tsd/filtrage.hpp"
 #include "tsd/filtrage/spline.hpp"
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <numeric>
 
 #define VERB(AA)
 #define RA_SAFE_MODE 0
@@ -18,8 +22,9 @@ struct AdaptationRythmeSimple: FiltreGen<T>
   /** Inverse du ratio precedent */
         increment = 1;
 
+  /** Fenêtre circulaire (ligne à retard), ifen : index de l'échantillon le plus ancien */
   Vecteur<T> fenetre;
-  entier nfen = 0;
+  entier nfen = 0, ifen = 0;
   sptr<Interpolateur<T>> interpolateur;
 
   AdaptationRythmeSimple(float ratio, sptr<Interpolateur<T>> itrp)
@@ -34,6 +39,11 @@ struct AdaptationRythmeSimple: FiltreGen<T>
       msg_avert("AdaptationRythmeSimple : npts interpolation = {} ({}).", nfen, itrp->nom);
   }
 
+  entier dim_sortie_max(entier n) const
+  {
+    retourne (entier) (ceil(ratio * n) + 10);
+  }
+
 
 
   void step(const Vecteur<T> &x, Vecteur<T> &y)
@@ -55,16 +65,14 @@ struct AdaptationRythmeSimple: FiltreGen<T>
 
     pour(auto i = 0; i < n; i++)
     {
-      // Rotation de la fenêtre
-      // TODO : ça serait pas mal que les interpolateurs puissent fonctionner de manière circulaire
-      // pour éviter cette rotation
-      fenetre.head(nfen-1) = fenetre.tail(nfen-1).clone();
-      fenetre(nfen-1) = *iptr++;
+      // Le nouvel échantillon remplace le plus ancien (pas de rotation, ni d'allocation)
+      fenetre(ifen) = *iptr++;
+      ifen = (ifen + 1) % nfen;
 
       tantque(phase < 1)
       {
         // phase = index entre deux échantillons
-        soit valeur_interpolée = interpolateur->step(fenetre, 0, phase);
+        soit valeur_interpolée = interpolateur->step(fenetre, ifen, phase);
         assertion(j < tmp_len);
         *optr++ = valeur_interpolée;
         j++;
@@ -79,6 +87,204 @@ struct AdaptationRythmeSimple: FiltreGen<T>
 };
 
 
+/////////////////////////////////////////////////////////////////////////
+// Ré-échantillonnage rationnel L / M
+/////////////////////////////////////////////////////////////////////////
+
+/** Filtre prototype (rythme L.fe), décomposé en L phases de Q coefficients */
+struct ReechanRationnelDesign
+{
+  entier L = 1, M = 1, K = 0, Q = 0;
+  /** Phase p (ligne p, contiguë) : coefficients h(p + (Q - 1 - k) L), k = 0 ... Q - 1,
+   *  dans l'ordre inverse, et multipliés par L (gain de l'insertion de zéros). */
+  Vecf coefs;
+};
+
+// Les designs sont mémorisés (un même ratio est typiquement utilisé par plusieurs voies)
+static sptr<const ReechanRationnelDesign> reechan_rationnel_design(entier L, entier M, float atten_db)
+{
+  static std::mutex mutex;
+  static std::map<tuple<entier, entier, float>, sptr<const ReechanRationnelDesign>> designs;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  soit clé = make_tuple(L, M, atten_db);
+  soit it  = designs.find(clé);
+  si(it != designs.end())
+    retourne it->second;
+
+  // Passe-bas à la plus petite des deux fréquences de Nyquist :
+  // bande passante jusqu'à 0,4 min(fe, fs), atténuation à partir de 0,5 min(fe, fs).
+  soit P = max(L, M);
+  Vecf h = (P == 1) ? Vecf::ones(1) : design_rif_fen_kaiser("lp", 0.45f / P, atten_db, 0.1f / P);
+
+  soit d = make_shared<ReechanRationnelDesign>();
+  d->L = L;
+  d->M = M;
+  d->K = h.rows();
+  d->Q = (d->K + L - 1) / L;
+  d->coefs = Vecf::zeros(L * d->Q);
+  pour(auto p = 0; p < L; p++)
+  {
+    pour(auto k = 0; k < d->Q; k++)
+    {
+      soit i = p + (d->Q - 1 - k) * L;
+      si(i < d->K)
+        d->coefs(p * d->Q + k) = L * h(i);
+    }
+  }
+  designs[clé] = d;
+  retourne d;
+}
+
+// Produit scalaire entre une phase du filtre et la fenêtre d'entrée
+// (accumulateurs indépendants, pour les données complexes : parties réelles et imaginaires entrelacées)
+template<typename T>
+static inline T reechan_produit(const float *c, const T *a, entier Q)
+{
+  si constexpr(est_complexe<T>())
+  {
+    soit af = (const float *) a;
+    float r0 = 0, i0 = 0, r1 = 0, i1 = 0;
+    entier k = 0;
+    pour(; k + 2 <= Q; k += 2)
+    {
+      r0 += c[k]   * af[2*k];
+      i0 += c[k]   * af[2*k+1];
+      r1 += c[k+1] * af[2*k+2];
+      i1 += c[k+1] * af[2*k+3];
+    }
+    pour(; k < Q; k++)
+    {
+      r0 += c[k] * af[2*k];
+      i0 += c[k] * af[2*k+1];
+    }
+    retourne T(r0 + r1, i0 + i1);
+  }
+  sinon
+  {
+    float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    entier k = 0;
+    pour(; k + 4 <= Q; k += 4)
+    {
+      s0 += c[k]   * a[k];
+      s1 += c[k+1] * a[k+1];
+      s2 += c[k+2] * a[k+2];
+      s3 += c[k+3] * a[k+3];
+    }
+    pour(; k < Q; k++)
+      s0 += c[k] * a[k];
+    retourne (s0 + s1) + (s2 + s3);
+  }
+}
+
+/** @brief Ré-échantillonnage d'un facteur L / M, structure polyphase
+ *
+ *  La sortie j correspond à l'instant u = j.M au rythme L.fe : elle est calculée avec la phase p = u mod L
+ *  du filtre prototype, sur la fenêtre se terminant par l'échantillon d'entrée n = u div L.
+ *  Seules les sorties conservées sont calculées (Q = K / L coefficients par sortie). */
+template<typename T>
+struct ReechanRationnel: FiltreGen<T>
+{
+  sptr<const ReechanRationnelDesign> design;
+  entier L = 1, M = 1, Q = 1;
+  // Q - 1 derniers échantillons d'entrée, puis le bloc courant
+  Vecteur<T> tampon;
+  // Prochaine sortie : phase, et index (relatif au bloc courant) de l'échantillon d'entrée le plus récent
+  entier phase = 0, n_suivant = 0;
+
+  ReechanRationnel(entier L, entier M, float atten_db)
+  {
+    si((L <= 0) || (M <= 0))
+      échec("filtre_reechan_rationnel : facteurs invalides (L = {}, M = {}).", L, M);
+    soit g = std::gcd(L, M);
+    this->L = L / g;
+    this->M = M / g;
+    design  = reechan_rationnel_design(this->L, this->M, atten_db);
+    Q       = design->Q;
+    tampon  = Vecteur<T>::zeros(Q - 1);
+  }
+
+  // Nombre de sorties pour un bloc de n échantillons
+  entier nb_sorties(entier n) const
+  {
+    soit reste = (int64_t) n - n_suivant;
+    si(reste <= 0)
+      retourne 0;
+    retourne (entier) ((reste * L - phase + M - 1) / M);
+  }
+
+  entier dim_sortie_max(entier n) const override
+  {
+    retourne (entier) (((int64_t) n * L + M - 1) / M + 1);
+  }
+
+  void step(const Vecteur<T> &x, Vecteur<T> &y) override
+  {
+    soit n = x.rows(), h = Q - 1;
+    si(tampon.rows() < h + n)
+    {
+      Vecteur<T> t = Vecteur<T>::zeros(h + n);
+      t.head(h) = tampon.head(h);
+      tampon = t;
+    }
+    soit a = tampon.data();
+    memcpy(a + h, x.data(), n * sizeof(T));
+
+    soit m = nb_sorties(n);
+    y.resize(m);
+    soit c = design->coefs.data();
+    pour(auto j = 0; j < m; j++)
+    {
+      // Fenêtre : a[n_suivant ... n_suivant + Q - 1]
+      y(j)  = reechan_produit<T>(c + phase * Q, a + n_suivant, Q);
+      phase += M;
+      n_suivant += phase / L;
+      phase %= L;
+    }
+    n_suivant -= n;
+    memmove(a, a + n, h * sizeof(T));
+  }
+};
+
+template<typename T>
+sptr<FiltreGen<T>> filtre_reechan_rationnel(entier L, entier M, float atten_db)
+{
+  retourne make_shared<ReechanRationnel<T>>(L, M, atten_db);
+}
+
+// Approximation du ratio par une fraction L / M (fractions continues),
+// avec L, M <= nmax, et une erreur relative inférieure à la précision d'un flottant.
+static bouléen ratio_rationnel(double ratio, entier nmax, entier &L, entier &M)
+{
+  int64_t h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+  double r = ratio;
+  pour(auto i = 0; i < 32; i++)
+  {
+    soit a  = (int64_t) floor(r);
+    soit h2 = a * h1 + h0, k2 = a * k1 + k0;
+    si((h2 > nmax) || (k2 > nmax))
+      retourne non;
+    h0 = h1; h1 = h2;
+    k0 = k1; k1 = k2;
+    si(abs(((double) h1) / k1 - ratio) <= 1e-6 * ratio)
+    {
+      L = h1;
+      M = k1;
+      retourne oui;
+    }
+    soit f = r - a;
+    si(f <= 0)
+      retourne non;
+    r = 1 / f;
+  }
+  retourne non;
+}
+
+static bouléen est_puissance_de_2(entier n)
+{
+  retourne (n > 0) && ((n & (n - 1)) == 0);
+}
+
 
 // Adaptation de rythme, ratio arbitraire
 template<typename T>
@@ -87,6 +293,9 @@ struct AdaptationRythmeArbitraire: Filtre<T,T,float>
   sptr<FiltreGen<T>> interpolateur;
   vector<sptr<FiltreGen<T>>> décimateurs, suréchantilloneurs;
 
+  /** Ré-échantillonneur polyphase, si le ratio est rationnel (petits termes) */
+  sptr<FiltreGen<T>> rationnel;
+
   /** Ratio d'interpolation / post-décimation */
   float facteur_post_interpolation;
 
@@ -113,6 +322,18 @@ struct AdaptationRythmeArbitraire: Filtre<T,T,float>
 
     VERB(msg("ratio de décimation / interpolation demandé : {}.", ratio_);)
 
+    // Ratio rationnel L / M (sauf puissances de 2, exactes avec la cascade demi-bande) :
+    // un seul filtre polyphase.
+    rationnel.reset();
+    entier L, M;
+    si(ratio_rationnel(ratio, 256, L, M)
+       && !(((L == 1) && est_puissance_de_2(M)) || ((M == 1) && est_puissance_de_2(L))))
+    {
+      VERB(msg(" ratio rationnel : L = {}, M = {}.", L, M);)
+      rationnel = filtre_reechan_rationnel<T>(L, M);
+      retourne;
+    }
+
     facteur_post_interpolation = ratio;
     soit nb_suréchantilloneurs = 0,
          nb_décimateurs = 0;
@@ -131,22 +352,18 @@ struct AdaptationRythmeArbitraire: Filtre<T,T,float>
       facteur_post_interpolation /= 2;
     }
 
-    // Structure polyphase avec la moitié des coefs nuls
-    // TODO : design plus efficace (fir_eq, etc.)
-    soit coefs = design_rif_fen(15, "lp", 0.25, "hn");
-
-    décimateurs.resize(nb_décimateurs);
-    pour(auto &d: décimateurs)
-      d = filtre_rif_demi_bande<float, T>(coefs);
-    // TODO : idem décimateur, moitié des coefs nuls
-    suréchantilloneurs.resize(nb_suréchantilloneurs);
-    pour(auto &d: suréchantilloneurs)
-      d = filtre_rif_ups<float, T>(coefs, 2);
+    // Bande passante de l'interpolateur final (facteur dans [0.5 ; 2[)
+    soit fcut = min(0.4f, facteur_post_interpolation / 2);
 
+    // Cascades demi-bande conçues ensemble : seule la bande utile doit être protégée
+    // (le nombre de coefficients diminue avec la fréquence d'échantillonnage de l'étage)
+    décimateurs.clear();
+    si(nb_décimateurs > 0)
+      décimateurs.push_back(filtre_rif_demi_bande_cascade<T>(nb_décimateurs, fcut, 60));
+    suréchantilloneurs.clear();
+    si(nb_suréchantilloneurs > 0)
+      suréchantilloneurs.push_back(filtre_rif_demi_bande_cascade<T>(nb_suréchantilloneurs, 0.4f, 60, oui));
 
-    // TODO: documenter
-    // [0.5 ; 2[
-    soit fcut = min(0.4f, facteur_post_interpolation / 2);
     soit itrp = itrp_sinc<T>({15, 256, fcut, "hn"});
     // TODO: voir meilleur interpolateur?
     interpolateur = filtre_itrp<T>(facteur_post_interpolation, itrp);
@@ -155,8 +372,29 @@ struct AdaptationRythmeArbitraire: Filtre<T,T,float>
               nb_décimateurs, nb_suréchantilloneurs, facteur_post_interpolation););
   }
 
+  entier dim_sortie_max(entier n) const override
+  {
+    si(ratio == 1)
+      retourne n;
+    si(rationnel)
+      retourne rationnel->dim_sortie_max(n);
+    pour(auto &d: décimateurs)
+      n = d->dim_sortie_max(n);
+    pour(auto &s: suréchantilloneurs)
+      n = s->dim_sortie_max(n);
+    si(abs(facteur_post_interpolation - 1) < 1e-6f)
+      retourne n;
+    retourne interpolateur->dim_sortie_max(n);
+  }
+
   void step(const Vecteur<T> &x, Vecteur<T> &y) override
   {
+    si(rationnel)
+    {
+      rationnel->step(x, y);
+      retourne;
+    }
+
     y = x;
 
     si(ratio == 1)
@@ -192,6 +430,8 @@ soit filtre_ra1  = filtre_reechan<float>;
 soit filtre_ra2  = filtre_reechan<cfloat>;
 soit filtre_ra3  = filtre_itrp<float>;
 soit filtre_ra4  = filtre_itrp<cfloat>;
+soit filtre_ra5  = filtre_reechan_rationnel<float>;
+soit filtre_ra6  = filtre_reechan_rationnel<cfloat>;
 }
 
 }
@@ -8,6 +8,8 @@
 #include <vector>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <atomic>
 
 
 using namespace std;
@@ -140,6 +142,354 @@ bouléen NTenseurDim::operator ==(const NTenseurDim &d2) const
   retourne oui;
 }
 
+/////////////////////////////////////////////////////////////////////////
+// Allocation des données des tableaux
+/////////////////////////////////////////////////////////////////////////
+
+// Chaque bloc alloué est précédé d'un entête indiquant son origine
+// (allocateur ou zone temporaire), afin de pouvoir le libérer correctement
+// quel que soit l'allocateur courant au moment de la libération.
+struct AllocEntête
+{
+  void  *origine;
+  size_t octets;
+  entier type; // 0 : allocateur, 1 : zone temporaire (ScopeScratch)
+};
+
+static constexpr size_t ALLOC_ALIGNEMENT  = TAB_ALIGNEMENT;
+
+static constexpr size_t alloc_arrondi(size_t octets)
+{
+  retourne ((octets + ALLOC_ALIGNEMENT - 1) / ALLOC_ALIGNEMENT) * ALLOC_ALIGNEMENT;
+}
+
+static constexpr size_t ALLOC_DIM_ENTÊTE  = alloc_arrondi(sizeof(AllocEntête));
+
+
+static thread_local TabAllocStats alloc_stats;
+
+TabAllocStats tab_alloc_stats()
+{
+  retourne alloc_stats;
+}
+
+void tab_alloc_stats_raz()
+{
+  alloc_stats = TabAllocStats();
+}
+
+// (aligned_alloc() : la taille doit être un multiple de l'alignement)
+static void *alloc_tas(size_t octets)
+{
+  alloc_stats.nb_allocations_tas++;
+  retourne aligned_alloc(ALLOC_ALIGNEMENT, alloc_arrondi(octets));
+}
+
+struct TabAllocateurTas: TabAllocateur
+{
+  void *alloue(size_t octets)
+  {
+    retourne alloc_tas(octets);
+  }
+  void libère(void *ptr, size_t octets)
+  {
+    free(ptr);
+  }
+};
+
+// Cache de blocs libres, par thread et par classe de taille
+struct CachePools
+{
+  static const entier LOG2_MIN = 6, LOG2_MAX = 24, NCLASSES = LOG2_MAX - LOG2_MIN + 1;
+  static const entier NB_MAX_PAR_CLASSE = 64;
+  static const size_t OCTETS_MAX = 32 << 20;
+
+  vector<void *> libres[NCLASSES];
+  size_t octets = 0;
+
+  ~CachePools();
+};
+
+// Pointeur trivialement destructible, afin que les libérations tardives
+// (après la destruction du cache à la fin du thread) restent possibles.
+static thread_local CachePools *cache_pools_actif = nullptr;
+
+static CachePools *cache_pools()
+{
+  static thread_local bouléen init = non;
+  si(!init)
+  {
+    static thread_local CachePools cache;
+    init = oui;
+    cache_pools_actif = &cache;
+  }
+  retourne cache_pools_actif;
+}
+
+CachePools::~CachePools()
+{
+  cache_pools_actif = nullptr;
+  pour(auto &l: libres)
+    pour(auto ptr: l)
+      free(ptr);
+}
+
+struct TabAllocateurPools: TabAllocateur
+{
+  static entier classe(size_t octets)
+  {
+    entier l2 = CachePools::LOG2_MIN;
+    tantque(((size_t) 1 << l2) < octets)
+      l2++;
+    retourne l2 - CachePools::LOG2_MIN;
+  }
+
+  void *alloue(size_t octets)
+  {
+    soit c = classe(octets);
+    si(c >= CachePools::NCLASSES)
+      retourne alloc_tas(octets);
+    soit cache = cache_pools();
+    si(cache && !cache->libres[c].empty())
+    {
+      soit ptr = cache->libres[c].back();
+      cache->libres[c].pop_back();
+      cache->octets -= (size_t) 1 << (c + CachePools::LOG2_MIN);
+      alloc_stats.nb_recyclages++;
+      retourne ptr;
+    }
+    retourne alloc_tas((size_t) 1 << (c + CachePools::LOG2_MIN));
+  }
+
+  void libère(void *ptr, size_t octets)
+  {
+    soit c = classe(octets);
+    si(c < CachePools::NCLASSES)
+    {
+      soit dim   = (size_t) 1 << (c + CachePools::LOG2_MIN);
+      soit cache = cache_pools_actif;
+      si(cache && ((entier) cache->libres[c].size() < CachePools::NB_MAX_PAR_CLASSE)
+          && (cache->octets + dim <= CachePools::OCTETS_MAX))
+      {
+        cache->libres[c].push_back(ptr);
+        cache->octets += dim;
+        retourne;
+      }
+    }
+    free(ptr);
+  }
+};
+
+static mutex                           alloc_mutex;
+static vector<sptr<TabAllocateur>>     alloc_enregistrés;
+static atomic<TabAllocateur *>         alloc_courant{nullptr};
+
+sptr<TabAllocateur> tab_allocateur_tas()
+{
+  retourne make_shared<TabAllocateurTas>();
+}
+
+sptr<TabAllocateur> tab_allocateur_pools()
+{
+  retourne make_shared<TabAllocateurPools>();
+}
+
+void tab_allocateur_def(sptr<TabAllocateur> allocateur)
+{
+  assertion_msg(allocateur, "tab_allocateur_def() : allocateur nul.");
+  const lock_guard<mutex> lock(alloc_mutex);
+  // Les allocateurs ne sont jamais détruits (des blocs peuvent être encore alloués)
+  alloc_enregistrés.push_back(allocateur);
+  alloc_courant = allocateur.get();
+}
+
+static TabAllocateur *allocateur_courant()
+{
+  soit a = alloc_courant.load(memory_order_acquire);
+  si(!a)
+  {
+    const lock_guard<mutex> lock(alloc_mutex);
+    a = alloc_courant.load();
+    si(!a)
+    {
+      alloc_enregistrés.push_back(tab_allocateur_pools());
+      a = alloc_enregistrés.back().get();
+      alloc_courant = a;
+    }
+  }
+  retourne a;
+}
+
+sptr<TabAllocateur> tab_allocateur()
+{
+  soit a = allocateur_courant();
+  const lock_guard<mutex> lock(alloc_mutex);
+  pour(auto &e: alloc_enregistrés)
+    si(e.get() == a)
+      retourne e;
+  retourne sptr<TabAllocateur>();
+}
+
+// Bloc de la zone temporaire : une référence par allocation en cours,
+// plus une pour la zone elle-même (tant que le bloc n'est pas retiré).
+struct ScratchBloc
+{
+  atomic<int64_t> refs{1};
+  size_t          dim = 0, pos = 0;
+  char           *data = nullptr;
+
+  static ScratchBloc *nouveau(size_t dim)
+  {
+    soit b  = new ScratchBloc();
+    b->dim  = alloc_arrondi(dim);
+    b->data = (char *) alloc_tas(dim);
+    retourne b;
+  }
+
+  void déréférence()
+  {
+    si(refs.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+      free(data);
+      delete this;
+    }
+  }
+};
+
+struct ScratchZone
+{
+  static const size_t NB_BLOCS_MAX = 8;
+  vector<ScratchBloc *> blocs;
+  entier profondeur = 0, courant = 0;
+  size_t dim_bloc   = 1 << 20;
+
+  void *alloue(size_t octets)
+  {
+    // Les gros tableaux ne passent pas par la zone temporaire
+    si(octets > dim_bloc / 4)
+      retourne nullptr;
+    tantque(courant < (entier) blocs.size())
+    {
+      soit b = blocs[courant];
+      si(b->pos + octets <= b->dim)
+      {
+        soit ptr = b->data + b->pos;
+        b->pos  += alloc_arrondi(octets);
+        b->refs.fetch_add(1, memory_order_relaxed);
+        retourne ptr;
+      }
+      courant++;
+    }
+    blocs.push_back(ScratchBloc::nouveau(dim_bloc));
+    retourne alloue(octets);
+  }
+
+  // Recyclage des blocs qui ne sont plus utilisés. Les blocs contenant encore des tableaux
+  // (ayant survécu au bloc de traitement) sont gardés tels quels (seule la fin reste utilisable),
+  // sauf s'ils sont trop nombreux : ils sont alors retirés de la zone, et seront libérés avec leur dernier tableau.
+  void recycle(bouléen tout_retirer)
+  {
+    vector<ScratchBloc *> gardés;
+    pour(auto b: blocs)
+    {
+      soit libre = b->refs.load(memory_order_acquire) == 1;
+      si(!tout_retirer && (libre || (gardés.size() < NB_BLOCS_MAX)))
+      {
+        si(libre)
+          b->pos = 0;
+        gardés.push_back(b);
+      }
+      sinon
+        b->déréférence();
+    }
+    blocs   = gardés;
+    courant = 0;
+  }
+
+  ~ScratchZone()
+  {
+    recycle(oui);
+  }
+};
+
+static thread_local ScratchZone scratch_zone;
+
+ScopeScratch::ScopeScratch(entier octets)
+{
+  si((scratch_zone.profondeur == 0) && scratch_zone.blocs.empty())
+    scratch_zone.dim_bloc = octets;
+  scratch_zone.profondeur++;
+}
+
+ScopeScratch::~ScopeScratch()
+{
+  si(--scratch_zone.profondeur == 0)
+    scratch_zone.recycle(non);
+}
+
+static void *tab_alloue(size_t octets)
+{
+  alloc_stats.nb_allocations++;
+  alloc_stats.octets += octets;
+
+  // Données alignées, et complétées jusqu'au multiple suivant de l'alignement
+  soit total = alloc_arrondi(octets) + ALLOC_DIM_ENTÊTE;
+  AllocEntête *e = nullptr;
+
+  si(scratch_zone.profondeur > 0)
+  {
+    si(soit ptr = scratch_zone.alloue(total))
+    {
+      alloc_stats.nb_scratch++;
+      e = (AllocEntête *) ptr;
+      e->origine = scratch_zone.blocs[scratch_zone.courant];
+      e->type    = 1;
+    }
+  }
+
+  si(!e)
+  {
+    soit a = allocateur_courant();
+    e = (AllocEntête *) a->alloue(total);
+    assertion_msg(e, "Tableau : échec d'allocation ({} octets).", octets);
+    e->origine = a;
+    e->type    = 0;
+  }
+
+  e->octets = total;
+  retourne ((char *) e) + ALLOC_DIM_ENTÊTE;
+}
+
+static void tab_libère(void *ptr)
+{
+  si(!ptr)
+    retourne;
+  soit e = (AllocEntête *) (((char *) ptr) - ALLOC_DIM_ENTÊTE);
+  si(e->type == 1)
+    ((ScratchBloc *) e->origine)->déréférence();
+  sinon
+    ((TabAllocateur *) e->origine)->libère(e, e->octets);
+}
+
+// Allocateur standard, pour que les descripteurs de tableaux (Tab::Impl)
+// passent aussi par les pools / la zone temporaire.
+template<typename T>
+struct AllocImpl
+{
+  using value_type = T;
+  AllocImpl() = default;
+  template<typename U>
+  AllocImpl(const AllocImpl<U> &){}
+  T *allocate(size_t n){retourne (T *) tab_alloue(n * sizeof(T));}
+  void deallocate(T *ptr, size_t){tab_libère(ptr);}
+  template<typename U>
+  bool operator ==(const AllocImpl<U> &) const {retourne oui;}
+  template<typename U>
+  bool operator !=(const AllocImpl<U> &) const {retourne non;}
+};
+
+static sptr<Tab::Impl> nouvel_impl();
+
 struct Tab::Impl: enable_shared_from_this<Tab::Impl>
 {
   // Pas forcément contenu peut être une expression !
@@ -166,6 +516,8 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
 
   Scalaire Tscalaire = ℝ;
   void *vals         = nullptr;
+  // Alignement garanti de la zone mémoire (tableaux de type MAP)
+  entier alignement  = 0;
   //ArrayXi dims;
   NTenseurDim dims;
   sptr<Impl> enfant;
@@ -178,7 +530,7 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
   {
     si((vals) && (type == VALEUR))
     {
-      free(vals);
+      tab_libère(vals);
     }
     vals = nullptr;
   }
@@ -240,7 +592,7 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
 
   sptr<Impl> clone() const
   {
-    sptr<Impl> res = make_shared<Impl>();
+    sptr<Impl> res = nouvel_impl();
     res->type        = Impl::Type::VALEUR;
     res->Tscalaire   = Tscalaire;
     res->nbits       = nbits;
@@ -251,14 +603,14 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
       soit ne = nb_éléments() * dim_scalaire();
       si(type != BLOCK)
       {
-        res->vals = malloc(ne);
+        res->vals = tab_alloue(ne);
         memcpy(res->vals, vals, ne);
       }
       sinon
       {
         soit nre = dims(0) * dim_scalaire(),
              nc = dims(1);
-        res->vals = malloc(ne);
+        res->vals = tab_alloue(ne);
         pour(auto col = 0; col < nc; col++)
           memcpy(res->get_ptr_at(0, col), get_ptr_at(0, col), nre);
       }
@@ -283,7 +635,7 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
     si((type == VALEUR) || (type == MAP))
       retourne ((Impl *) this)->shared_from_this();
 
-    soit res = make_shared<Impl>();
+    soit res = nouvel_impl();
     res->type       = VALEUR;
     res->dims       = dims;
     res->Tscalaire  = Tscalaire;
@@ -300,7 +652,7 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
       soit e = enfant;
       si(e->type != VALEUR)
         e = e->eval();
-      res->vals = malloc(ne * ds);
+      res->vals = tab_alloue(ne * ds);
       memcpy(res->vals,
              ((char *) e->vals) + seg_i0 * ds,
              dims(0) * ds);
@@ -313,7 +665,7 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
       si(e->type != VALEUR)
         e = e->eval();
 
-      res->vals = malloc(ne * ds);
+      res->vals = tab_alloue(ne * ds);
 
       soit nre  = e->dims(0);
       soit iptr = ((char *) e->vals) + blk_r0 * ds + blk_c0 * ds * nre;
@@ -331,13 +683,13 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
       break;
     case CONST_1:
     {
-      res->vals = malloc(nb_éléments() * dim_scalaire());
+      res->vals = tab_alloue(nb_éléments() * dim_scalaire());
       APPLIQUE_METHODE((*res), setOnes());
       break;
     }
     case CONST_0:
     {
-      res->vals = malloc(nb_éléments() * dim_scalaire());
+      res->vals = tab_alloue(nb_éléments() * dim_scalaire());
       APPLIQUE_METHODE((*res), setZero());
       break;
     }
@@ -443,6 +795,11 @@ struct Tab::Impl: enable_shared_from_this<Tab::Impl>
 
 
 
+static sptr<Tab::Impl> nouvel_impl()
+{
+  retourne allocate_shared<Tab::Impl>(AllocImpl<Tab::Impl>());
+}
+
 void *Tab::rawptr()
 {
   retourne impl->vals;
@@ -457,12 +814,12 @@ Tab format_as(const Tab &x)
 {
   Tab y;
 
-  y.impl              = make_shared<Tab::Impl>();
+  y.impl              = nouvel_impl();
   y.impl->type        = Tab::Impl::Type::VALEUR;
   y.impl->Tscalaire   = x.impl->Tscalaire;
   y.impl->nbits       = x.impl->nbits;
   y.impl->dims        = x.impl->dims;
-  y.impl->vals        = malloc(y.impl->nb_éléments() * y.impl->dim_scalaire());
+  y.impl->vals        = tab_alloue(y.impl->nb_éléments() * y.impl->dim_scalaire());
 
   retourne y;
 }
@@ -483,6 +840,21 @@ bouléen Tab::est_reference() const
 }
 
 
+bouléen Tab::est_aligné() const
+{
+  si(!impl || !impl->vals || (((uintptr_t) impl->vals) % TAB_ALIGNEMENT))
+    retourne non;
+  // Remonte jusqu'au tableau propriétaire des données
+  soit i = impl.get();
+  tantque(i->type == Impl::SEGMENT)
+    i = i->enfant.get();
+  si(i->type == Impl::VALEUR)
+    retourne oui;
+  si(i->type == Impl::MAP)
+    retourne i->alignement >= TAB_ALIGNEMENT;
+  retourne non;
+}
+
 Tab Tab::head(entier n) const
 {
   retourne segment(0, n);
@@ -496,7 +868,7 @@ Tab Tab::tail(entier n) const
 Tab Tab::col(entier num) const
 {
   Tab res;
-  res.impl = make_shared<Impl>();
+  res.impl = nouvel_impl();
 
   //msg("Tab::col() -> reference.");
 
@@ -515,7 +887,7 @@ Tab Tab::col(entier num) const
 Tab Tab::segment(entier i0, entier n) const
 {
   Tab res;
-  res.impl = make_shared<Impl>();
+  res.impl = nouvel_impl();
 
   assertion_msg(i0 + n <= rows(), "Tab::segment({},{}): dépassement ({} éléments).", i0, n, rows());
 
@@ -543,7 +915,7 @@ Tab Tab::reshape(entier m, entier n) const
 Tab Tab::block(entier r0, entier nr, entier c0, entier nc) const
 {
   Tab res;
-  res.impl = make_shared<Impl>();
+  res.impl = nouvel_impl();
   res.impl->type = Impl::Type::BLOCK;
   res.impl->blk_r0 = r0;
   res.impl->blk_c0 = c0;
@@ -681,7 +1053,7 @@ Tab Tab::même_format() const
 
 Tab::Tab()
 {
-  impl = make_shared<Impl>();
+  impl = nouvel_impl();
 }
 
 
@@ -693,7 +1065,7 @@ void setup(Tab::Impl &impl, entier n, entier m)
     impl.dims = NTenseurDim::dim1(n);
 
   si(impl.nb_éléments() > 0)
-    impl.vals = malloc(impl.nb_éléments() * impl.dim_scalaire());
+    impl.vals = tab_alloue(impl.nb_éléments() * impl.dim_scalaire());
   sinon
     impl.vals = nullptr;
 }
@@ -705,14 +1077,18 @@ void Tab::resize(entier n, entier m)
     retourne;
 
   si((impl->vals) && (impl->type == Impl::VALEUR))
-    free(impl->vals);
+    tab_libère(impl->vals);
+
+  // Une référence (map, segment) redimensionnée devient un tableau propre
+  impl->type = Impl::VALEUR;
+  impl->enfant.reset();
 
   setup(*impl, n, m);
 }
 
 Tab::Tab(Scalaire s, entier reso, entier n, entier m)
 {
-  impl = make_shared<Impl>();
+  impl = nouvel_impl();
   impl->type      = Impl::VALEUR;
   impl->Tscalaire = s;
   impl->nbits     = reso;
@@ -720,13 +1096,14 @@ Tab::Tab(Scalaire s, entier reso, entier n, entier m)
   setup(*impl, n, m);
 }
 
-Tab Tab::map(Scalaire s, entier reso, entier n, entier m, void *data)
+Tab Tab::map(Scalaire s, entier reso, entier n, entier m, void *data, entier alignement)
 {
   Tab res;
-  res.impl = make_shared<Impl>();
-  res.impl->type      = Impl::MAP;
-  res.impl->Tscalaire = s;
-  res.impl->nbits     = reso;
+  res.impl = nouvel_impl();
+  res.impl->type       = Impl::MAP;
+  res.impl->Tscalaire  = s;
+  res.impl->nbits      = reso;
+  res.impl->alignement = alignement;
 
   si(m > 1)
     res.impl->dims = NTenseurDim::dim2(n, m);
@@ -816,7 +1193,7 @@ void Tab::conservativeResize(entier n, entier m)
 
   memcpy(impl->vals, optr, min(l1, l2));
 
-  free(optr);
+  tab_libère(optr);
 }
 
 Tab Tab::transpose_int() const
@@ -1554,11 +1931,11 @@ Tab Tab::lsq(const Tab &b) const
   assertion_msg(rows() == n, "Tab::lsq: nombre de lignes incohérent.");
 
   Tab y;
-  y.impl              = make_shared<Tab::Impl>();
+  y.impl              = nouvel_impl();
   y.impl->Tscalaire   = b.impl->Tscalaire;
   y.impl->nbits       = b.impl->nbits;
   y.impl->dims        = NTenseurDim::dim1(m);
-  y.impl->vals        = malloc(y.impl->nb_éléments() * y.impl->dim_scalaire());
+  y.impl->vals        = tab_alloue(y.impl->nb_éléments() * y.impl->dim_scalaire());
 
   TR(*this, [&]<typename T, entier ndims>(TabT<T,ndims> &)
   {
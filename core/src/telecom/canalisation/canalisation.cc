@@ -1,17 +1,349 @@
 #include "tsd/tsd.hpp"
 #include "tsd/filtrage.hpp"
 #include "tsd/fourier.hpp"
+#include "tsd/telecom.hpp"
+#include <cstring>
 
 using namespace tsd::filtrage;
+using namespace tsd::fourier;
 
 namespace tsd::telecom {
 
 
+/////////////////////////////////////////////////////////////////////////
+// Banc de filtres polyphase, au fil de l'eau
+/////////////////////////////////////////////////////////////////////////
 
+// Prototype du banc de filtres (gain unitaire en DC)
+static Vecf pfb_prototype(const CanaliseurPFBConfig &config, entier &R)
+{
+  soit M = config.nb_canaux;
+  si(M < 2)
+    échec("Banc de filtres polyphase : nombre de canaux invalide ({}).", M);
+  si((config.sur_échantillonnage != 1) && (config.sur_échantillonnage != 2))
+    échec("Banc de filtres polyphase : sur-échantillonnage invalide ({}, attendu : 1 ou 2).",
+          config.sur_échantillonnage);
+  si((config.sur_échantillonnage == 2) && ((M % 2) != 0))
+    échec("Banc de filtres polyphase : le sur-échantillonnage nécessite un nombre de canaux pair ({}).", M);
+
+  R = M / config.sur_échantillonnage;
+
+  si(!config.h.est_vide())
+    retourne config.h;
 
+  soit df = (config.sur_échantillonnage == 1 ? 0.2f : 0.5f) / M;
+  soit h = design_rif_fen_kaiser("lp", 0.5f / M, config.atten_db, df);
+  retourne h / h.somme();
+}
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define TSD_PFB_SIMD 1
+#else
+# define TSD_PFB_SIMD 0
+#endif
 
+/** @brief Sommes polyphase : w[j] = somme_q c[j + q.pas] x[j + q.pas], pour j = 0 ... n-1
+ *
+ *  Comme pour les noyaux RIF par bloc, les sorties sont calculées par paquets de 4 vecteurs de W flottants,
+ *  les accumulateurs restant dans les registres pendant le parcours des Q branches. */
+template<entier W>
+static inline void pfb_sommes_noyau(const float *c, const float *x, float *w, entier n, entier Q, entier pas)
+{
+  typedef float vf __attribute__((vector_size(4 * W)));
+  entier j0 = 0;
+  pour(; j0 + 4 * W <= n; j0 += 4 * W)
+  {
+    vf a[4] = {}, u, v;
+    pour(auto q = 0; q < Q; q++)
+    {
+      soit cq = c + j0 + q * pas, xq = x + j0 + q * pas;
+      pour(auto l = 0; l < 4; l++)
+      {
+        memcpy(&u, cq + l * W, sizeof(vf));
+        memcpy(&v, xq + l * W, sizeof(vf));
+        a[l] += u * v;
+      }
+    }
+    memcpy(w + j0, a, sizeof(a));
+  }
+  pour(; j0 < n; j0++)
+  {
+    float s = 0;
+    pour(auto q = 0; q < Q; q++)
+      s += c[j0 + q * pas] * x[j0 + q * pas];
+    w[j0] = s;
+  }
+}
 
+/** @brief Addition-recouvrement : a[j + q.pas] += c[j + q.pas] z[j], pour j = 0 ... n-1 et q = 0 ... Q-1
+ *
+ *  Chaque paquet de z est chargé une seule fois pour les Q branches. */
+template<entier W>
+static inline void pfb_ola_noyau(const float *c, const float *z, float *a, entier n, entier Q, entier pas)
+{
+  typedef float vf __attribute__((vector_size(4 * W)));
+  entier j0 = 0;
+  pour(; j0 + 2 * W <= n; j0 += 2 * W)
+  {
+    vf z0, z1, u, v;
+    memcpy(&z0, z + j0, sizeof(vf));
+    memcpy(&z1, z + j0 + W, sizeof(vf));
+    pour(auto q = 0; q < Q; q++)
+    {
+      soit cq = c + j0 + q * pas;
+      soit aq = a + j0 + q * pas;
+      memcpy(&u, cq, sizeof(vf));
+      memcpy(&v, aq, sizeof(vf));
+      v += u * z0;
+      memcpy(aq, &v, sizeof(vf));
+      memcpy(&u, cq + W, sizeof(vf));
+      memcpy(&v, aq + W, sizeof(vf));
+      v += u * z1;
+      memcpy(aq + W, &v, sizeof(vf));
+    }
+  }
+  pour(; j0 < n; j0++)
+    pour(auto q = 0; q < Q; q++)
+      a[j0 + q * pas] += c[j0 + q * pas] * z[j0];
+}
+
+#if TSD_PFB_SIMD
+__attribute__((target("avx2,fma"), flatten))
+static void pfb_ola_avx2(const float *c, const float *z, float *a, entier n, entier Q, entier pas)
+{
+  pfb_ola_noyau<8>(c, z, a, n, Q, pas);
+}
+
+__attribute__((target("avx512f"), flatten))
+static void pfb_ola_avx512(const float *c, const float *z, float *a, entier n, entier Q, entier pas)
+{
+  pfb_ola_noyau<16>(c, z, a, n, Q, pas);
+}
+
+__attribute__((target("avx2,fma"), flatten))
+static void pfb_sommes_avx2(const float *c, const float *x, float *w, entier n, entier Q, entier pas)
+{
+  pfb_sommes_noyau<8>(c, x, w, n, Q, pas);
+}
+
+__attribute__((target("avx512f"), flatten))
+static void pfb_sommes_avx512(const float *c, const float *x, float *w, entier n, entier Q, entier pas)
+{
+  pfb_sommes_noyau<16>(c, x, w, n, Q, pas);
+}
+#endif
+
+static void pfb_sommes(const float *c, const float *x, float *w, entier n, entier Q, entier pas)
+{
+# if TSD_PFB_SIMD
+  soit niveau = tfr_simd_niveau();
+  si(niveau == 3)
+    retourne pfb_sommes_avx512(c, x, w, n, Q, pas);
+  si(niveau == 2)
+    retourne pfb_sommes_avx2(c, x, w, n, Q, pas);
+# endif
+  pfb_sommes_noyau<4>(c, x, w, n, Q, pas);
+}
+
+static void pfb_ola(const float *c, const float *z, float *a, entier n, entier Q, entier pas)
+{
+# if TSD_PFB_SIMD
+  soit niveau = tfr_simd_niveau();
+  si(niveau == 3)
+    retourne pfb_ola_avx512(c, z, a, n, Q, pas);
+  si(niveau == 2)
+    retourne pfb_ola_avx2(c, z, a, n, Q, pas);
+# endif
+  pfb_ola_noyau<4>(c, z, a, n, Q, pas);
+}
+
+// Transposition par tuiles (src : nr lignes, nc colonnes ; dst : nc lignes, nr colonnes)
+static void pfb_transpose(const cfloat *src, entier nr, entier nc, cfloat *dst)
+{
+  const entier T = 16;
+  pour(auto c0 = 0; c0 < nc; c0 += T)
+  {
+    soit c1 = min(nc, c0 + T);
+    pour(auto r0 = 0; r0 < nr; r0 += T)
+    {
+      soit r1 = min(nr, r0 + T);
+      pour(auto c = c0; c < c1; c++)
+        pour(auto r = r0; r < r1; r++)
+          dst[r * nc + c] = src[c * nr + r];
+    }
+  }
+}
+
+struct CanaliseurPFBImpl: CanaliseurPFB
+{
+  // M canaux, décimation R, Q coefficients par branche, K coefficients
+  entier M = 0, R = 0, Q = 0, K = 0;
+  // Coefficients dans l'ordre inverse, complétés à Q.M (forme polyphase : M lignes, Q colonnes),
+  // dupliqués pour les parties réelles et imaginaires, et mis à l'échelle de la TFR (normalisée)
+  Vecf hd;
+  // Q.M - 1 échantillons d'historique, puis le bloc courant
+  Veccf tampon;
+  // Position, dans le tampon, du début de la fenêtre de la prochaine sortie
+  entier pos = 0;
+  // Instant de la prochaine sortie, modulo M
+  entier phase = 0;
+  // Sommes polyphase (une colonne par instant de sortie), et leurs TFR
+  Tabcf W, F;
+  sptr<FFTPlan> plan;
+
+  CanaliseurPFBImpl(const CanaliseurPFBConfig &config)
+  {
+    M = config.nb_canaux;
+    soit h = pfb_prototype(config, R);
+    K = h.rows();
+    Q = (K + M - 1) / M;
+
+    // Fenêtre de Q.M échantillons se terminant en t : le coefficient h_{qM + p}
+    // s'applique à l'échantillon d'indice (Q - 1 - q).M + (M - 1 - p) de la fenêtre.
+    Vecf hp = Vecf::zeros(Q * M);
+    hp.head(K) = h;
+    soit H = forme_polyphase(hp.reverse(), M);
+    soit g = sqrt((float) M);
+    hd.resize(2 * Q * M);
+    pour(auto i = 0; i < Q * M; i++)
+      hd(2 * i) = hd(2 * i + 1) = g * H.data()[i];
+
+    tampon = Veccf::zeros(Q * M - 1);
+    pos    = R - 1;
+    phase  = (R - 1) % M;
+    plan   = tfrplan_création(M, oui);
+  }
+
+  // Sommes polyphase pour la fenêtre débutant à a, avec rotation de d échantillons
+  void sommes(const cfloat *a, entier d, cfloat *w)
+  {
+    const float *x = (const float *) a, *c = hd.data();
+    soit n0 = 2 * (M - d);
+    pfb_sommes(c, x, (float *) (w + d), n0, Q, 2 * M);
+    pfb_sommes(c + n0, x + n0, (float *) w, 2 * d, Q, 2 * M);
+  }
+
+  void step(const Veccf &x, Tabcf &Y)
+  {
+    soit n = x.rows(), Hn = Q * M - 1;
+
+    si(tampon.rows() < Hn + n)
+    {
+      Veccf t(Hn + n);
+      memcpy(t.data(), tampon.data(), Hn * sizeof(cfloat));
+      tampon = t;
+    }
+    memcpy(tampon.data() + Hn, x.data(), n * sizeof(cfloat));
+
+    // Sorties dont la fenêtre est complète : pos + Q.M <= Hn + n
+    soit nb = (pos <= n - 1) ? (n - 1 - pos) / R + 1 : 0;
+    Y.resize(nb, M);
+
+    si(nb > 0)
+    {
+      W.resize(M, nb);
+      soit e = tampon.data();
+      // Rotation : la somme polyphase r se place en (r + t_m + 1) mod M
+#     if LIBTSD_USE_OMP
+#     pragma omp parallel for
+#     endif
+      pour(auto i = 0; i < nb; i++)
+        sommes(e + pos + i * R, (phase + i * R + 1) % M, W.data() + i * M);
+
+      plan->step_batch(W, F, 0, oui);
+
+      // Une colonne par canal
+      pfb_transpose(F.data(), M, nb, Y.data());
+    }
+
+    // Historique
+    memmove(tampon.data(), tampon.data() + n, Hn * sizeof(cfloat));
+    pos  += nb * R - n;
+    phase = (phase + nb * R) % M;
+  }
+};
+
+struct SynthétiseurPFBImpl: SynthétiseurPFB
+{
+  entier M = 0, R = 0, Q = 0, K = 0;
+  // Prototype (gain R), complété à Q.M, dupliqué pour les parties réelles et imaginaires,
+  // et mis à l'échelle de la TFR inverse (normalisée)
+  Vecf gd;
+  // Accumulateur (addition-recouvrement) : Q.M - R échantillons en attente, puis le bloc courant
+  Veccf acc;
+  // Entrées du bloc (une colonne par instant), et leurs TFR inverses
+  Tabcf Xt, Z;
+  // (mR - D) mod M, pour le prochain instant m
+  entier phase = 0;
+  sptr<FFTPlan> plan;
+
+  SynthétiseurPFBImpl(const CanaliseurPFBConfig &config)
+  {
+    M = config.nb_canaux;
+    soit h = pfb_prototype(config, R);
+    K = h.rows();
+    Q = (K + M - 1) / M;
+
+    soit g = R * sqrt((float) M);
+    gd = Vecf::zeros(2 * Q * M);
+    pour(auto i = 0; i < K; i++)
+      gd(2 * i) = gd(2 * i + 1) = g * h(i);
+
+    acc   = Veccf::zeros(Q * M);
+    soit D = K - R;
+    phase = ((-D % M) + M) % M;
+    plan  = tfrplan_création(M, non);
+  }
+
+  void step(const Tabcf &X, Veccf &y)
+  {
+    soit nb = X.rows();
+    assertion_msg((nb == 0) || (X.cols() == M),
+                  "Synthétiseur polyphase : nombre de canaux invalide ({}, attendu : {}).", X.cols(), M);
+    y.resize(nb * R);
+    si(nb == 0)
+      retourne;
+
+    soit na = Q * M - R, nt = (nb - 1) * R + Q * M;
+    si(acc.rows() < nt)
+    {
+      Veccf t(nt);
+      memcpy(t.data(), acc.data(), na * sizeof(cfloat));
+      acc = t;
+    }
+    memset((void *) (acc.data() + na), 0, (nt - na) * sizeof(cfloat));
+
+    // Une colonne par instant
+    Xt.resize(M, nb);
+    pfb_transpose(X.data(), nb, M, Xt.data());
+
+    plan->step_batch(Xt, Z, 0, non);
+
+    pour(auto i = 0; i < nb; i++)
+    {
+      // Échantillon r de la sortie : TFR inverse en (r + phase) mod M
+      const float *z = (const float *) (Z.data() + i * M), *c = gd.data();
+      float *a = (float *) (acc.data() + i * R);
+      soit n0 = 2 * (M - phase);
+      pfb_ola(c, z + 2 * phase, a, n0, Q, 2 * M);
+      pfb_ola(c + n0, z, a + n0, 2 * phase, Q, 2 * M);
+      phase = (phase + R) % M;
+    }
+
+    memcpy(y.data(), acc.data(), nb * R * sizeof(cfloat));
+    memmove(acc.data(), acc.data() + nb * R, na * sizeof(cfloat));
+  }
+};
+
+sptr<CanaliseurPFB> canaliseur_pfb(const CanaliseurPFBConfig &config)
+{
+  retourne make_shared<CanaliseurPFBImpl>(config);
+}
+
+sptr<SynthétiseurPFB> synthétiseur_pfb(const CanaliseurPFBConfig &config)
+{
+  retourne make_shared<SynthétiseurPFBImpl>(config);
+}
 
 // Creation of a polyphase decimation filter structure
 //
@@ -61,7 +393,7 @@ namespace tsd::telecom {
 // Description
 // Merge m different signals into a single vector, by frequency multiplexing.
 // The signals are shifted at the following normalized frequencies: 0, 1/m, 2/m, ..., (m-1)/m.
-// Note: this could be done more effectively using a modulated filter bank (Harris method, reciprocal algorithm of the unchannelize function).
+// Note: computed by the streaming polyphase synthesis filter bank (synthétiseur_pfb(), critically sampled).
 // <programlisting>
 // fs = 1e3;
 // mod = mod_init("bpsk", fs=1e3,fi=0,fsymb=50);
@@ -75,49 +407,10 @@ namespace tsd::telecom {
 // <imageobject><imagedata fileref="ex_channelize.png" format="PNG"/></imageobject>
 Veccf canalisation(const Tabcf X, const Vecf &h)
 {
-
-  // A FAIRE : remplacer par un filtre au fil de l'eau
-
-  soit n = X.rows(); // Nb éch / canal
-  soit m = X.cols(); // Nb canaux
-
-//    y = zeros(n*m,1);
-//
-//    pour i = 1:m
-//        nu = (i-1) / m; // normalized frequency
-//        xu = intdec(real(X(:,i)), m) + %i * intdec(imag(X(:,i)), m);
-//        xm = xu .* exp(2*%pi*%i*nu*(0:n*m-1)');
-//        y = y + xm;
-//    end
-//
-
-
-  // IDFT suivant les colonnes (dim n°1)
-  Tabcf Y(n, m);
-  pour(auto k = 0; k < m; k++)
-    Y.col(k) = tsd::fourier::ifft(X.col(k));
-
-    //soit Y = tsd::fourier::ifft(X);
-
-  // Y : chaque ligne = une fréquence donnée
-
-  // (3) polyphase partition of the filter
-  soit H = forme_polyphase(h, m); // Transférer ceci dans le module de filtrage
-  // H : m lignes, len(h)/m colonnes
-
-    // (2) Sortie du filtre polyphase
-  soit n2 = n;
-  soit n3 = n2 + (length(h)-1)/m;
-  soit XF = Tabcf::zeros(m, n3);
-  pour(auto i = 0; i < m; i++)
-    XF.row(i) = tsd::filtrage::convol<cfloat,float>(H.row(i),Y.row(i));
-
-  // (1) polyphase partition of the signal
-  // On suppose qu'on a un bloc de nchn échantillons
-  // A partir du signal d'entrée de n échantillons,
-  // on forme nchn signaux de n / nchn échantillons
-  retourne iforme_polyphase<cfloat>(XF);
-  // Chaque ligne de X peut être traitée séparément
+  CanaliseurPFBConfig config;
+  config.nb_canaux = X.cols();
+  config.h         = h;
+  retourne synthétiseur_pfb(config)->step(X);
 }
 
 
@@ -42,6 +42,11 @@ struct FHSSModulation: Filtre<cfloat,cfloat,FHSSConfig>
 
     index = 0;
   }
+  entier dim_sortie_max(entier n) const
+  {
+    retourne ra->dim_sortie_max(n);
+  }
+
   void step(const Veccf &x, Veccf &y)
   {
     msg("Calcul FHSS...");
@@ -116,6 +121,11 @@ struct DSSSModulation: Filtre<cfloat,cfloat,DSSSConfig>
     ra = tsd::filtrage::filtre_reechan<cfloat>(((float) nbits) / c.osf_in);
   }
 
+  entier dim_sortie_max(entier n) const
+  {
+    retourne ra->dim_sortie_max(n);
+  }
+
   void step(const Veccf &x, Veccf &y)
   {
     soit &config = Configurable<DSSSConfig>::config;
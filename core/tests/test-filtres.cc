@@ -1,5 +1,6 @@
 #include "tsd/tsd-all.hpp"
 #include "tsd/tests.hpp"
+#include <chrono>
 
 using namespace std;
 
@@ -292,6 +293,291 @@ void test_filtfilt()
   }
 }
 
+// Filtrage zéro-phase par blocs parallèles VS filtrage séquentiel (aller - retour)
+static void test_filtfilt_parallèle()
+{
+  msg_majeur("Test filtfilt par blocs parallèles...");
+
+  soit n = 300000;
+  Vecf x = randn(n) + 1.0f;
+  Veccf xc = (randn(n) + 1.0f) + ⅈ * randn(n);
+
+  soit teste = [&](const string &nom, const Design &d, std::function<Vecf (const Vecf &, entier)> ff,
+                   std::function<Veccf (const Veccf &, entier)> ffc, float tol)
+  {
+    soit yref = filtfilt(d, x);
+    soit yref_c = filtfilt(d, xc);
+    pour(auto nb_threads: {1, 4})
+    {
+      soit err  = abs(ff(x, nb_threads) - yref).valeur_max() / abs(yref).valeur_max();
+      soit errc = abs(ffc(xc, nb_threads) - yref_c).valeur_max() / abs(yref_c).valeur_max();
+      msg("  {}, {} thread(s) : erreur relative = {:e} (réel), {:e} (complexe)", nom, nb_threads, err, errc);
+      assertion_msg((err < tol) && (errc < tol), "filtfilt parallèle ({}) : erreur trop importante.", nom);
+    }
+    // En place
+    Vecf z = x.clone();
+    ff(z, -1);
+    soit err = abs(z - yref).valeur_max() / abs(yref).valeur_max();
+    msg("  {}, en place : erreur relative = {:e}", nom, err);
+    assertion_msg(err < tol, "filtfilt parallèle ({}, en place) : erreur trop importante.", nom);
+  };
+
+  // Span en place si nb_threads < 0 (4 threads)
+  soit en_place = [](auto f)
+  {
+    retourne [f](const Vecf &x, entier nb_threads)
+    {
+      si(nb_threads < 0)
+      {
+        Vecf &z = const_cast<Vecf &>(x);
+        f(std::span<const float>(z.data(), z.rows()), std::span<float>(z.data(), z.rows()), 4);
+        retourne z;
+      }
+      Vecf y(x.rows());
+      f(std::span<const float>(x.data(), x.rows()), std::span<float>(y.data(), y.rows()), nb_threads);
+      retourne y;
+    };
+  };
+
+  {
+    soit h = design_riia(8, "lp", "ellip", 0.05, 0.1, 60);
+    teste("RII elliptique ordre 8", h,
+          en_place([&](auto x, auto y, entier nt){filtfilt<float>(h, x, y, nt);}),
+          [&](const Veccf &x, entier nt){retourne filtfilt(h, x, nt);}, 1e-4);
+  }
+  {
+    // Pôles proches du cercle unité (régime transitoire long)
+    soit h = design_riia(4, "lp", "butt", 0.005, 0.1, 60);
+    teste("RII Butterworth fc = 0.005", h,
+          en_place([&](auto x, auto y, entier nt){filtfilt<float>(h, x, y, nt);}),
+          [&](const Veccf &x, entier nt){retourne filtfilt(h, x, nt);}, 1e-4);
+  }
+  {
+    soit h = design_rif_fen(63, "lp", 0.05);
+    teste("RIF", h,
+          en_place([&](auto x, auto y, entier nt){filtfilt_rif<float>(h, x, y, nt);}),
+          [&](const Veccf &x, entier nt){retourne filtfilt_rif(h, x, nt);}, 1e-5);
+  }
+
+  // Durée de traitement
+  {
+    soit h = design_riia(8, "lp", "ellip", 0.05, 0.1, 60);
+    soit mesure = [&](std::function<void ()> f)
+    {
+      soit t0 = std::chrono::steady_clock::now();
+      f();
+      soit t1 = std::chrono::steady_clock::now();
+      retourne std::chrono::duration<double, std::milli>(t1 - t0).count();
+    };
+    Vecf y;
+    soit t0 = mesure([&](){y = filtfilt(Design(h), x);});
+    soit t1 = mesure([&](){y = filtfilt(h, x, 1);});
+    soit t4 = mesure([&](){y = filtfilt(h, x, 4);});
+    msg("  RII ordre 8, {} échantillons : séquentiel : {:.1f} ms, par blocs : {:.1f} ms (1 thread), {:.1f} ms (4 threads).",
+        n, t0, t1, t4);
+  }
+}
+
+static void test_filtres_fixes()
+{
+  msg_majeur("Test filtres en virgule fixe (Q15 / Q31)...");
+
+  soit n = 20000;
+  Vecf xf = randn(n) * 0.15f;
+
+  // Référence flottante, puis comparaison en LSB
+  soit teste = [&]<typename T>(const string &nom, sptr<FiltreFixe<T>> f, const Vecf &yref,
+                                const vector<entier> &blocs, float tol_lsb)
+  {
+    vector<T> x(n), y(f->dim_sortie_max(n) + 1);
+    vers_fixe<T>(std::span<const float>(xf.data(), n), x);
+    entier i = 0, m = 0, ib = 0;
+    tantque(i < n)
+    {
+      soit d = min(blocs[ib++ % blocs.size()], n - i);
+      m += f->step(std::span<const T>(x.data() + i, d), std::span<T>(y.data() + m, y.size() - m));
+      i += d;
+    }
+    assertion(m == yref.rows());
+    Vecf yf(m);
+    depuis_fixe<T>(std::span<const T>(y.data(), m), std::span<float>(yf.data(), m));
+    soit lsb = std::ldexp(1.0f, 1 - 8 * (entier) sizeof(T));
+    soit err = abs(yf - yref).valeur_max() / lsb;
+    msg("  {} : Q{}, erreur max = {:.1f} LSB, max |acc| = {}, saturations = {}", nom, f->nb_bits_frac,
+        err, f->stats.max_abs_acc, f->stats.nb_saturations);
+    assertion_msg(err <= tol_lsb, "Filtre virgule fixe ({}) : erreur trop importante.", nom);
+    assertion_msg(f->stats.nb_saturations == 0, "Filtre virgule fixe ({}) : saturations inattendues.", nom);
+    assertion(f->stats.nb_échantillons == m);
+  };
+
+  {
+    soit h = design_rif_fen(63, "lp", 0.1);
+    soit yref = filtre_rif<float, float>(h)->step(xf);
+    teste.operator()<int16_t>("RIF K=63", filtre_rif_fixe<int16_t>(h), yref, {n}, 3);
+    teste.operator()<int16_t>("RIF K=63, blocs", filtre_rif_fixe<int16_t>(h), yref, {1, 7, 100, 33, 1000}, 3);
+    // (erreur dominée par la référence flottante)
+    teste.operator()<int32_t>("RIF K=63", filtre_rif_fixe<int32_t>(h), yref, {n}, 1000);
+
+    // Nombre impair de coefficients (dernière paire incomplète)
+    soit h2 = design_rif_fen(20, "lp", 0.2);
+    soit yref2 = filtre_rif<float, float>(h2)->step(xf);
+    teste.operator()<int16_t>("RIF K=20", filtre_rif_fixe<int16_t>(h2), yref2, {17, 64, 5}, 3);
+  }
+  {
+    soit R = 3;
+    soit h = design_rif_fen(47, "lp", 0.5 / R);
+    soit yref = filtre_rif_decim<float, float>(h, R)->step(xf);
+    teste.operator()<int16_t>("RIF décimation R=3", filtre_rif_decim_fixe<int16_t>(h, R), yref, {n}, 3);
+    teste.operator()<int16_t>("RIF décimation R=3, blocs", filtre_rif_decim_fixe<int16_t>(h, R), yref, {1, 2, 50, 301}, 3);
+    teste.operator()<int32_t>("RIF décimation R=3, blocs", filtre_rif_decim_fixe<int32_t>(h, R), yref, {4, 1000}, 1000);
+  }
+  {
+    soit h = design_riia(4, "lp", "butt", 0.1, 0.1, 60);
+    // (état initial nul, comme en virgule fixe)
+    Vecf x0 = Vecf::zeros(1) | xf;
+    soit yref = filtre_sois<float>(h)->step(x0).tail(n);
+    teste.operator()<int16_t>("SOIS Butterworth ordre 4", filtre_sois_fixe<int16_t>(h), yref, {n}, 20);
+    teste.operator()<int32_t>("SOIS Butterworth ordre 4", filtre_sois_fixe<int32_t>(h), yref, {100, 7}, 5000);
+  }
+
+  // Saturations
+  {
+    soit h = Vecf::valeurs({0.75f, 1.0f});
+    soit f = filtre_rif_fixe<int16_t>(h);
+    vector<int16_t> x(100, 30000), y(100);
+    f->step(x, y);
+    msg("  RIF gain 1.75 : {} saturations, max |sortie| = {}", f->stats.nb_saturations, f->stats.max_abs_sortie);
+    assertion(f->stats.nb_saturations == 99);
+    assertion((y[0] == 22500) && (y[99] == 32767));
+    f->raz_stats();
+    assertion(f->stats.nb_saturations == 0);
+  }
+
+  // Débit, par rapport au flottant
+  {
+    soit h = design_rif_fen(63, "lp", 0.1);
+    soit nb = 256 * 1024;
+    Vecf x = randn(nb) * 0.1f, y(nb);
+    vector<int16_t> x16(nb), y16(nb);
+    vector<int32_t> x32(nb), y32(nb);
+    vers_fixe<int16_t>(std::span<const float>(x.data(), nb), x16);
+    vers_fixe<int32_t>(std::span<const float>(x.data(), nb), x32);
+    soit mesure = [&](std::function<void ()> f)
+    {
+      double t = 1e30;
+      pour(auto essai = 0; essai < 5; essai++)
+      {
+        soit t0 = std::chrono::steady_clock::now();
+        f();
+        soit t1 = std::chrono::steady_clock::now();
+        t = min(t, std::chrono::duration<double, std::nano>(t1 - t0).count() / nb);
+      }
+      retourne t;
+    };
+    soit ff = filtre_rif<float, float>(h);
+    soit f16 = filtre_rif_fixe<int16_t>(h);
+    soit f32 = filtre_rif_fixe<int32_t>(h);
+    soit tf  = mesure([&](){ff->step(std::span<const float>(x.data(), nb), std::span<float>(y.data(), nb));});
+    soit t16 = mesure([&](){f16->step(x16, y16);});
+    soit t32 = mesure([&](){f32->step(x32, y32);});
+    msg("  RIF K=63 : flottant {:.2f} ns / éch, Q15 {:.2f} ns / éch, Q31 {:.2f} ns / éch.", tf, t16, t32);
+  }
+}
+
+// Référence CIC : convolution par la réponse impulsionnelle (porte de dimension RM)^N
+static Vecd cic_ref_rimp(const CICConfig &c)
+{
+  Vecd h = Vecd::ones(1);
+  pour(auto k = 0; k < c.N; k++)
+  {
+    // (somme glissante sur RM coefficients)
+    soit RM = c.R * c.M;
+    Vecd h2 = Vecd::zeros(h.rows() + RM - 1);
+    double s = 0;
+    pour(auto i = 0; i < h2.rows(); i++)
+    {
+      si(i < h.rows())
+        s += h(i);
+      si(i >= RM)
+        s -= h(i - RM);
+      h2(i) = s;
+    }
+    h = h2;
+  }
+  retourne h;
+}
+
+template<typename Ti>
+static void test_cic_unit(const CICConfig &c, char mode)
+{
+  soit n = (mode == 'd') ? 40 * c.R + 17 : 300;
+  // Entrées entières (type interne : pas de quantification)
+  Vecf x(n);
+  pour(auto i = 0; i < n; i++)
+    x(i) = (float) ((rand() % 2001) - 1000);
+
+  soit h = cic_ref_rimp(c);
+  soit R = c.R;
+  soit gain = ((mode == 'd') ? 1.0 : (double) R) / pow((double) R * c.M, c.N);
+
+  // Signal haute cadence (entrée en décimation, entrée sur-échantillonnée en interpolation)
+  soit nh = (mode == 'd') ? n : n * R;
+  Vecd xh = Vecd::zeros(nh);
+  pour(auto i = 0; i < n; i++)
+    xh((mode == 'd') ? i : i * R) = x(i);
+  // (en décimation, seulement aux instants j.R)
+  soit pas = (mode == 'd') ? R : 1;
+  Vecd yref = Vecd::zeros((nh + pas - 1) / pas);
+  pour(auto j = 0; j < yref.rows(); j++)
+    pour(auto k = 0; (k < h.rows()) && (k <= j * pas); k++)
+      yref(j) += h(k) * xh(j * pas - k);
+  yref *= gain;
+
+  // Traitement par blocs de dimensions variées
+  soit f = filtre_cic<float, Ti>(c, mode);
+  Vecf y;
+  entier i = 0, ib = 0;
+  vector<entier> blocs = {1, 7, R, 3 * R + 1, 1000};
+  tantque(i < n)
+  {
+    soit d = min(blocs[ib++ % blocs.size()], n - i);
+    y = y | f->step(x.segment(i, d));
+    i += d;
+  }
+  assertion(y.rows() == yref.rows());
+  soit err = abs(y.as<double>() - yref).valeur_max() / abs(yref).valeur_max();
+  msg("  CIC {} R={}, N={}, M={}, {} bits : erreur relative = {:e}", mode == 'd' ? "décimation" : "interpolation",
+      R, c.N, c.M, 8 * sizeof(Ti), err);
+  assertion_msg(err < 1e-6, "CIC : erreur trop importante.");
+}
+
+static void test_cic()
+{
+  msg_majeur("Test filtre CIC au fil de l'eau...");
+  test_cic_unit<entier>({.R = 16, .N = 4, .M = 1}, 'd');
+  test_cic_unit<entier>({.R = 16, .N = 4, .M = 2}, 'd');
+  test_cic_unit<entier>({.R = 5,  .N = 8, .M = 1}, 'd');
+  test_cic_unit<entier>({.R = 8,  .N = 3, .M = 2}, 'i');
+  test_cic_unit<int64_t>({.R = 4096, .N = 4, .M = 1}, 'd');
+  test_cic_unit<int64_t>({.R = 1024, .N = 5, .M = 2}, 'd');
+
+  // Débit
+  {
+    soit n = 4 * 1024 * 1024;
+    Vecf x(n);
+    pour(auto i = 0; i < n; i++)
+      x(i) = (float) (((i % 1024) * 7919) % 255 - 127);
+    pour(auto R: {16, 4096})
+    {
+      soit f = filtre_cic<float, int64_t>({.R = R, .N = 5, .M = 1}, 'd');
+      soit t0 = std::chrono::steady_clock::now();
+      soit y = f->step(x);
+      soit t1 = std::chrono::steady_clock::now();
+      soit t = std::chrono::duration<double>(t1 - t0).count();
+      msg("  CIC décimation R={}, N=5, 64 bits : {:.0f} Méch/s", R, n / t * 1e-6);
+    }
+  }
+}
 
 void test_design_biquad()
 {
@@ -608,6 +894,489 @@ void test_filtre_rii()
 
 
 
+// RII par bloc (représentation d'état) VS filtre_sois() / filtre_rii(), sur des blocs de dimensions variées
+template<typename T>
+static void test_sois_bloc_unit(const FRat<cfloat> &h, RIIStructure structure, entier dim_bloc)
+{
+  soit n = 3000;
+  // (composante continue : l'état est initialisé avec le premier échantillon)
+  Vecteur<T> x(n);
+  si constexpr(est_complexe<T>())
+    x = (randn(n) + 1.0f) + ⅈ * randn(n);
+  sinon
+    x = randn(n) + 1.0f;
+
+  soit f1 = filtre_sois<T>(h, structure), f2 = filtre_sois_bloc<T>(h, structure, dim_bloc);
+  soit yref = f1->step(x);
+
+  Vecteur<T> y(n);
+  entier i = 0, k = 0;
+  soit dims = {100, 1, 37, 512, 16, 3};
+  tantque(i < n)
+  {
+    soit d = min(n - i, (entier) dims.begin()[k++ % dims.size()]);
+    y.segment(i, d) = f2->step(x.segment(i, d));
+    i += d;
+  }
+  soit err = abs(y - yref).valeur_max() / abs(yref).valeur_max();
+  msg("  ordre {}, structure {}, L = {}, {} : erreur relative = {:e}",
+      h.denom.coefs.rows(), (entier) structure, dim_bloc, est_complexe<T>() ? "complexe" : "réel", err);
+  assertion_msg(err < 1e-4, "filtre_sois_bloc : erreur trop importante ({:e}).", err);
+}
+
+static void test_sois_bloc()
+{
+  msg_majeur("Test RII par bloc (représentation d'état)...");
+
+  pour(auto structure: {FormeDirecte2, FormeDirecte1})
+  {
+    pour(auto ordre: {2, 5, 8})
+    {
+      soit h = design_riia(ordre, "lp", "ellip", 0.1, 0.1, 60);
+      pour(auto L: {0, 8, 32})
+      {
+        test_sois_bloc_unit<float>(h, structure, L);
+        test_sois_bloc_unit<cfloat>(h, structure, L);
+      }
+    }
+  }
+
+  // Forme directe générique (filtre_rii)
+  {
+    soit h = design_riia(4, "lp", "butt", 0.2, 0.1, 60);
+    soit n = 1000;
+    Veccf x = randn(n) + ⅈ * randn(n);
+    soit y1 = filtre_rii<cfloat, cfloat>(h)->step(x);
+    soit y2 = filtre_rii_bloc<cfloat, cfloat>(h)->step(x);
+    soit err = abs(y1 - y2).valeur_max() / abs(y1).valeur_max();
+    msg("  filtre_rii_bloc : erreur relative = {:e}", err);
+    assertion_msg(err < 1e-4, "filtre_rii_bloc : erreur trop importante ({:e}).", err);
+  }
+
+  // Débit (filtre elliptique d'ordre 8)
+  {
+    soit h = design_riia(8, "lp", "ellip", 0.1, 0.1, 60);
+    soit n = 64 * 1024;
+    Vecf x = randn(n);
+    soit f1 = filtre_sois<float>(h), f2 = filtre_sois_bloc<float>(h);
+    soit mesure = [&](sptr<FiltreGen<float>> f)
+    {
+      Vecf y;
+      double t = 1e30;
+      pour(auto essai = 0; essai < 5; essai++)
+      {
+        soit t0 = std::chrono::steady_clock::now();
+        pour(auto i = 0; i < n; i += 1024)
+          f->step(x.segment(i, 1024), y);
+        soit t1 = std::chrono::steady_clock::now();
+        t = min(t, std::chrono::duration<double, std::nano>(t1 - t0).count() / n);
+      }
+      retourne t;
+    };
+    msg("  Ordre 8 (réel) : chaine SOIS : {:.2f} ns / éch, par bloc : {:.2f} ns / éch.", mesure(f1), mesure(f2));
+  }
+}
+
+
+// Traitement échantillon par échantillon (step_éch) : identique au traitement par bloc, sans allocation
+static void test_step_éch()
+{
+  msg_majeur("Test traitement échantillon par échantillon...");
+
+  soit n = 200;
+  soit x = randn(n);
+  soit h = FRat<float>::rii(Vecf::valeurs({0.1f}), Vecf::valeurs({1.0f, -0.9f}));
+
+  vector<tuple<string, std::function<sptr<FiltreGen<float>>()>>> filtres =
+  {
+    {"RIF",               [](){retourne filtre_rif<float,float>(design_rif_fen(15, "lp", 0.2));}},
+    {"RII",               [&](){retourne filtre_rii<float,float>(h);}},
+    {"SOIS",              [](){retourne filtre_sois<float>(design_riia(4, "lp", "butt", 0.1, 0.1, 60));}},
+    {"SOIS par bloc",     [](){retourne filtre_sois_bloc<float>(design_riia(4, "lp", "butt", 0.1, 0.1, 60));}},
+    {"lissage exp.",      [](){retourne filtre_lexp<float>(0.1);}},
+    {"moyenne glissante", [](){retourne filtre_mg<float,double>(8);}},
+    {"ligne à retard",    [](){retourne ligne_a_retard<float>(5);}},
+    {"DC",                [](){retourne filtre_dc<float>(0.01);}}
+  };
+
+  pour(auto &[nom, création]: filtres)
+  {
+    soit f1 = création(), f2 = création();
+    soit y1 = f1->step(x);
+    Vecf y2(n);
+    tab_alloc_stats_raz();
+    pour(auto i = 0; i < n; i++)
+      y2(i) = f2->step(x(i));
+    soit nalloc = tab_alloc_stats().nb_allocations;
+    soit err = abs(y1 - y2).valeur_max();
+    msg("{} : erreur = {}, allocations = {}", nom, err, nalloc);
+    assertion_msg(err < 1e-6f, "step_éch ({}) : résultat différent du traitement par bloc.", nom);
+    assertion_msg(nalloc == 0, "step_éch ({}) : allocations.", nom);
+  }
+}
+
+// Traitement sur des zones mémoire de l'appelant (std::span)
+static void test_step_span()
+{
+  msg_majeur("Test traitement sur std::span...");
+
+  soit n = 101;
+  soit x = randn(n);
+
+  vector<tuple<string, std::function<sptr<FiltreGen<float>>()>>> filtres =
+  {
+    {"RIF",               [](){retourne filtre_rif<float,float>(design_rif_fen(15, "lp", 0.2));}},
+    {"moyenne glissante", [](){retourne filtre_mg<float,double>(8);}},
+    {"SOIS",              [](){retourne filtre_sois<float>(design_riia(4, "lp", "butt", 0.1, 0.1, 60));}},
+    {"SOIS par bloc",     [](){retourne filtre_sois_bloc<float>(design_riia(4, "lp", "butt", 0.1, 0.1, 60));}},
+    {"décimateur",        [](){retourne decimateur<float>(3);}},
+    {"sur-échantillonage",[](){retourne filtre_rif_ups<float,float>(design_rif_fen(15, "lp", 0.2), 2);}}
+  };
+
+  pour(auto &[nom, création]: filtres)
+  {
+    soit f1 = création(), f2 = création(), f3 = création();
+
+    Vecf yref = f1->step(x);
+
+    // Sortie pré-allouée
+    vector<float> y(f2->dim_sortie_max(n));
+    soit ny = f2->step(std::span<const float>(x.data(), n), std::span<float>(y));
+
+    // En place
+    soit nmax = f3->dim_sortie_max(n);
+    vector<float> z(max(n, nmax));
+    std::copy(x.data(), x.data() + n, z.data());
+    soit nz = f3->step(std::span<const float>(z.data(), n), std::span<float>(z));
+
+    msg("{} : n = {}, dim sortie = {} (max {}).", nom, n, ny, nmax);
+    assertion((ny == (size_t) yref.rows()) && (nz == ny));
+    assertion((entier) ny <= nmax);
+    soit e1 = abs(yref - Vecf::map(y.data(), ny)).valeur_max(),
+         e2 = abs(yref - Vecf::map(z.data(), nz)).valeur_max();
+    assertion_msg((e1 < 1e-6f) && (e2 < 1e-6f), "step(span) {} : erreurs = {}, {}", nom, e1, e2);
+  }
+}
+
+// Filtre RIF : traitement par bloc (noyaux vectorisés) VS échantillon par échantillon,
+// et VS produit de convolution direct.
+// forme : 0 = coefficients quelconques, 1 = symétriques, -1 = anti-symétriques (repliement)
+template<typename T, typename Tc>
+static void test_rif_bloc_unit(entier K, entier forme)
+{
+  Vecf hr = design_rif_fen(K, "lp", 0.2);
+  si((forme == 0) && (K > 1))
+    hr *= linspace(1, 2, K);
+  sinon si(forme < 0)
+    hr -= hr.reverse().clone();
+  soit h = hr.template as<Tc>();
+  si constexpr(est_complexe<Tc>())
+    h *= std::polar(1.0f, 0.3f);
+
+  soit f1 = filtre_rif<Tc, T>(h), f2 = filtre_rif<Tc, T>(h);
+
+  // Blocs de dimensions variées (reste des paquets vectoriels, traitement échantillon par échantillon)
+  Vecteur<T> xtot, ytot;
+  pour(auto n: {1, 7, 8, 33, 100, 1000})
+  {
+    Vecteur<T> x = randn(n).template as<T>();
+    si constexpr(est_complexe<T>())
+      x += ⅈ * randn(n);
+    soit y1 = f1->step(x);
+    Vecteur<T> y2(n);
+    pour(auto i = 0; i < n; i++)
+      y2(i) = f2->step(x(i));
+    soit err = abs(y1 - y2).valeur_max();
+    assertion_msg(err < 1e-5f, "RIF bloc (K = {}, n = {}, forme = {}) : erreur = {}", K, n, forme, err);
+    xtot = xtot | x;
+    ytot = ytot | y1;
+  }
+
+  soit n = xtot.rows();
+  Vecteur<T> yref(n);
+  pour(auto i = 0; i < n; i++)
+  {
+    T s = 0;
+    pour(auto k = 0; k <= min(i, K-1); k++)
+      s += h(k) * xtot(i-k);
+    yref(i) = s;
+  }
+  soit err = abs(ytot - yref).valeur_max();
+  assertion_msg(err < 1e-5f, "RIF bloc (K = {}, forme = {}) : erreur / convolution = {}", K, forme, err);
+}
+
+static void test_rif_bloc()
+{
+  msg_majeur("Test RIF par bloc...");
+  pour(auto K: {1, 3, 4, 15, 16, 63, 255, 256})
+  {
+    pour(auto forme: {0, 1, -1})
+    {
+      test_rif_bloc_unit<float, float>(K, forme);
+      test_rif_bloc_unit<cfloat, float>(K, forme);
+      test_rif_bloc_unit<cfloat, cfloat>(K, forme);
+    }
+  }
+
+  // Performances (filtre adapté), avec et sans repliement des coefficients symétriques
+  pour(auto K: {63, 127, 255})
+  {
+    pour(auto sym: {oui, non})
+    {
+      soit n  = 16 * 1024;
+      soit h  = design_rif_fen(K, "lp", 0.2);
+      si(!sym)
+        h(0) *= 1.001f;
+      soit f  = filtre_rif<float, cfloat>(h);
+      Veccf x = randn(n) + ⅈ * randn(n), y(n);
+      f->step(x, y);
+      soit t0 = std::chrono::steady_clock::now();
+      pour(auto i = 0; i < 10; i++)
+        f->step(x, y);
+      soit t1 = std::chrono::steady_clock::now();
+      soit t  = std::chrono::duration<double, std::milli>(t1 - t0).count() / 10;
+      msg("RIF K = {}, réel x complexe, {} : {:.2f} ms pour {} échantillons ({:.1f} Méch/s).",
+          K, sym ? "symétrique" : "quelconque", t, n, n / (t * 1e3));
+    }
+  }
+}
+
+// Choix automatique d'implémentation RIF (directe / OLA)
+// Banc multi-canaux : comparaison avec un filtre_rif() par canal
+template<typename Tc, typename T>
+static void test_rif_multi_unit(entier K, entier nc, entier ng)
+{
+  Vecteur<Tc> h;
+  si constexpr(est_complexe<Tc>())
+    h = randn(K) + ⅈ * randn(K);
+  sinon
+    h = randn(K);
+
+  soit f = filtre_rif_multi<Tc, T>(h, nc, ng);
+  vector<sptr<FiltreGen<T>>> fd;
+  pour(auto c = 0; c < nc; c++)
+    fd.push_back(filtre_rif<Tc, T>(h));
+
+  float err = 0;
+  // Blocs de dimensions différentes (continuité des lignes à retard)
+  pour(auto n: {100, 1, 37, 256})
+  {
+    TabT<T,2> x(n, nc);
+    pour(auto c = 0; c < nc; c++)
+    {
+      si constexpr(est_complexe<T>())
+        x.col(c) = randn(n) + ⅈ * randn(n);
+      sinon
+        x.col(c) = randn(n);
+    }
+    soit y = f->step(x);
+    assertion((y.rows() == n) && (y.cols() == nc));
+    pour(auto c = 0; c < nc; c++)
+    {
+      Vecteur<T> xc = x.col(c);
+      soit yd = fd[c]->step(xc);
+      Vecteur<T> yc = y.col(c);
+      err = max(err, abs(yc - yd).valeur_max());
+    }
+  }
+  msg("  K = {}, {} canaux, {} groupe(s) : erreur = {}", K, nc, ng, err);
+  assertion_msg(err < 1e-4f, "RIF multi (K = {}, {} canaux) : erreur = {}", K, nc, err);
+}
+
+static void test_rif_multi()
+{
+  msg_majeur("Test RIF multi-canaux...");
+  // Coefficients symétriques (repliés)
+  pour(auto nc: {1, 5, 32})
+  {
+    Vecf hs = design_rif_fen(31, "lp", 0.2);
+    Vecf ha = hs - hs.reverse().clone();
+    soit f = [&](const Vecf &h)
+    {
+      soit fm = filtre_rif_multi<float, cfloat>(h, nc);
+      soit fd = filtre_rif<float, cfloat>(h);
+      Tabcf x(300, nc);
+      pour(auto c = 0; c < nc; c++)
+        x.col(c) = randn(300) + ⅈ * randn(300);
+      soit y = fm->step(x);
+      Veccf x0 = x.col(nc - 1), y0 = y.col(nc - 1);
+      soit err = abs(y0 - fd->step(x0)).valeur_max();
+      assertion_msg(err < 1e-5f, "RIF multi (coefficients symétriques) : erreur = {}", err);
+    };
+    f(hs);
+    f(ha);
+  }
+  pour(auto K: {1, 7, 64})
+  {
+    pour(auto nc: {1, 3, 16, 64})
+    {
+      test_rif_multi_unit<float, float>(K, nc, 1);
+      test_rif_multi_unit<float, cfloat>(K, nc, 1);
+      test_rif_multi_unit<cfloat, cfloat>(K, nc, 1);
+    }
+    test_rif_multi_unit<float, cfloat>(K, 16, 4);
+    test_rif_multi_unit<cfloat, cfloat>(K, 10, 3);
+  }
+
+  // Performances : un filtre par canal / banc multi-canaux
+  {
+    soit K = 63, nc = 32, n = 4096;
+    // (coefficients quelconques : pas de repliement)
+    Vecf h = randn(K);
+    Tabcf x(n, nc);
+    pour(auto c = 0; c < nc; c++)
+      x.col(c) = randn(n) + ⅈ * randn(n);
+    vector<sptr<FiltreGen<cfloat>>> fd;
+    vector<Veccf> xc(nc);
+    pour(auto c = 0; c < nc; c++)
+    {
+      fd.push_back(filtre_rif<float, cfloat>(h));
+      xc[c] = x.col(c);
+    }
+    soit f = filtre_rif_multi<float, cfloat>(h, nc);
+    Tabcf y;
+    Veccf yc;
+    f->step(x, y);
+    soit t0 = std::chrono::steady_clock::now();
+    pour(auto r = 0; r < 4; r++)
+      pour(auto c = 0; c < nc; c++)
+        fd[c]->step(xc[c], yc);
+    soit t1 = std::chrono::steady_clock::now();
+    pour(auto r = 0; r < 4; r++)
+      f->step(x, y);
+    soit t2 = std::chrono::steady_clock::now();
+    soit d = [&](auto a, auto b)
+    {
+      retourne std::chrono::duration<double, std::nano>(b - a).count() / (4.0 * n * nc);
+    };
+    msg("K = {}, {} canaux (complexes) : un filtre par canal : {:.2f} ns / éch, multi-canaux : {:.2f} ns / éch.",
+        K, nc, d(t0, t1), d(t1, t2));
+  }
+}
+
+// Convolution partitionnée : comparaison avec l'implémentation directe,
+// blocs d'entrée de dimensions quelconques
+template<typename T>
+static void test_rif_partition_unit(entier K, entier B, bouléen non_uniforme)
+{
+  Vecf h = randn(K);
+  soit f  = filtre_rif_partition<T>(h, B, non_uniforme);
+  soit fd = filtre_rif<float, T>(h);
+
+  soit n = 8 * K + 37 * B + 5;
+  Vecteur<T> x;
+  si constexpr(est_complexe<T>())
+    x = randn(n) + ⅈ * randn(n);
+  sinon
+    x = randn(n);
+
+  soit yd = fd->step(x);
+  Vecteur<T> y(n), yb;
+  entier i = 0, j = 0, k = 0;
+  tantque(i < n)
+  {
+    // Blocs d'entrée : 1, B, 3B + 1, B / 2, ...
+    entier dims[] = {1, B, 3 * B + 1, max(B / 2, (entier) 1), 2 * B};
+    soit c = min(dims[(k++) % 5], n - i);
+    f->step(x.segment(i, c), yb);
+    y.segment(j, yb.rows()) = yb;
+    i += c;
+    j += yb.rows();
+  }
+  assertion(j == (n / B) * B);
+  soit err = abs(y.head(j) - yd.head(j)).valeur_max() / abs(yd).valeur_max();
+  msg("  K = {}, B = {}, {} : erreur relative = {}", K, B, non_uniforme ? "non uniforme" : "uniforme", err);
+  assertion_msg(err < 1e-5f, "RIF partitionné (K = {}, B = {}) : erreur = {}", K, B, err);
+}
+
+static void test_rif_partition()
+{
+  msg_majeur("Test RIF partitionné...");
+  pour(auto nu: {non, oui})
+  {
+    pour(auto K: {1, 16, 100, 1000, 4096})
+    {
+      test_rif_partition_unit<float>(K, 64, nu);
+      test_rif_partition_unit<cfloat>(K, 64, nu);
+    }
+    test_rif_partition_unit<float>(300, 7, nu);
+    test_rif_partition_unit<cfloat>(300, 32, nu);
+  }
+
+  // Partitions / OLA / direct, filtre de 4096 coefficients
+  {
+    soit K = 4096, B = 64, n = 64 * 1024;
+    soit h = design_rif_fen(K, "lp", 0.1);
+    Veccf x = randn(n) + ⅈ * randn(n);
+    soit mesure = [&](sptr<FiltreGen<cfloat>> f, entier dim_bloc)
+    {
+      Veccf y;
+      f->step(x.head(dim_bloc), y);
+      soit t0 = std::chrono::steady_clock::now();
+      pour(auto i = 0; i + dim_bloc <= n; i += dim_bloc)
+        f->step(x.segment(i, dim_bloc), y);
+      soit t1 = std::chrono::steady_clock::now();
+      retourne std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    };
+    soit tp  = mesure(filtre_rif_partition<cfloat>(h, B), B);
+    soit tnu = mesure(filtre_rif_partition<cfloat>(h, B, oui), B);
+    soit to  = mesure(filtre_rif_fft<cfloat>(h, 8192 - K), 8192 - K);
+    msg("K = {} : partitions uniformes (B = {}) : {:.1f} ns / éch, non uniformes : {:.1f} ns / éch, OLA (Ne = {}) : {:.1f} ns / éch.",
+        K, B, tp, tnu, 8192 - K, to);
+  }
+}
+
+static void test_rif_auto()
+{
+  msg_majeur("Test RIF auto...");
+
+  // Calibration (profil enregistré dans le dossier de test)
+  setenv("TSD_PROFIL_RIF", "./build/test-log/profil-rif.txt", 1);
+  soit p = rif_calibration();
+  assertion(rif_profil().calibré);
+  assertion((p.ns_coef_réel > 0) && (p.ns_coef_complexe > 0) && (p.ns_flop_tfr > 0));
+  FILE *f = fopen("./build/test-log/profil-rif.txt", "rt");
+  assertion_msg(f, "Profil de calibration non enregistré.");
+  fclose(f);
+
+  // Filtre court : implémentation directe ; filtre long : OLA (sauf si contrainte de latence)
+  soit c1 = rif_choix_implémentation(7, 1024, -1, non, oui);
+  assertion(c1.type == RIFImplémentation::DIRECTE);
+  soit c2 = rif_choix_implémentation(2047, 8192, -1, oui, oui);
+  assertion(c2.type != RIFImplémentation::DIRECTE);
+  soit c3 = rif_choix_implémentation(2047, 8192, 0, oui, oui);
+  assertion((c3.type == RIFImplémentation::DIRECTE) && (c3.latence == 0));
+  soit c4 = rif_choix_implémentation(511, 0, 1024, oui, oui);
+  assertion(c4.latence <= 1024);
+  // Filtre long et faible latence : convolution partitionnée
+  soit c5 = rif_choix_implémentation(4096, 0, 256, oui, non);
+  assertion((c5.type == RIFImplémentation::PARTITIONNÉE) && (c5.latence <= 256) && (c5.retard == 0));
+
+  // Même sortie que l'implémentation directe (au retard près)
+  pour(auto K: {15, 255, 1023})
+  {
+    soit h = design_rif_fen(K, "lp", 0.1);
+    soit dim_bloc = 2048;
+    RIFImplémentation choix;
+    soit fa = filtre_rif_auto<cfloat>(h, dim_bloc, -1, &choix);
+    soit fd = filtre_rif<float, cfloat>(h);
+    msg("K = {} : implémentation {}, Ne = {}, latence = {}, retard = {}, coût estimé = {:.2f} ns / éch.",
+        K, choix.type == RIFImplémentation::OLA ? "OLA" :
+           choix.type == RIFImplémentation::PARTITIONNÉE ? "partitionnée" : "directe",
+        choix.dim_bloc, choix.latence, choix.retard, choix.coût);
+
+    soit n = 32 * dim_bloc;
+    Veccf x = randn(n) + ⅈ * randn(n);
+    soit ya = filtre_par_bloc(fa, x, dim_bloc),
+         yd = filtre_par_bloc(fd, x, dim_bloc);
+    soit r = choix.retard, m = ya.rows() - r - K;
+    assertion(m > n / 2);
+    soit err = abs(ya.segment(r + K, m) - yd.segment(K, m)).valeur_max();
+    msg("  erreur = {}", err);
+    assertion_msg(err < 1e-4f, "RIF auto (K = {}) : erreur = {}", K, err);
+  }
+}
+
 void test_rif_freq()
 {
   msg_majeur("Test RIF freq...");
@@ -716,6 +1485,13 @@ void test_filtres()
   test_ligne_a_retard();
   test_filtre_rii();
   test_riia();
+  test_sois_bloc();
+  test_step_éch();
+  test_step_span();
+  test_rif_bloc();
+  test_rif_multi();
+  test_rif_partition();
+  test_rif_auto();
 
   {
 
@@ -776,6 +1552,9 @@ void test_filtres()
 
   test_filtre_rif();
   test_filtfilt();
+  test_filtfilt_parallèle();
+  test_filtres_fixes();
+  test_cic();
   test_filtrage_ola();
   test_filtre_mg();
   test_design_biquad();
@@ -1,6 +1,10 @@
 #include "tsd/tsd-all.hpp"
 #include "tsd/tests.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 //using namespace std;
 
 static void test_fftplan(entier n)
@@ -36,6 +40,28 @@ static void test_rfftplan()
   assertion(err < 1e-6);
 }
 
+// Plans TFR réelle / TFR inverse réelle (dimensions paires et impaires, changement de dimension)
+static void test_irfftplan()
+{
+  msg_majeur("Tests plans FFT réelle / FFT inverse réelle...");
+  soit plan  = rtfrplan_création();
+  soit iplan = irtfrplan_création();
+  Veccf X;
+  Vecf x2;
+  pour(auto n: {2, 8, 60, 101, 127, 1000, 1024, 1001})
+  {
+    soit x = randn(n);
+    plan->step(x, X);
+    iplan->step(X, x2);
+
+    soit err1 = abs(X - fft(x.as_complex())).valeur_max(),
+         err2 = abs(x2 - x).valeur_max();
+    msg("  n = {} : erreur fft = {:e}, erreur ifft = {:e}", n, err1, err2);
+    // (n = 1001 : calcul via CZT, moins précis)
+    assertion_msg((err1 < 1e-3) && (err2 < 1e-3), "Erreur plan FFT réelle (n = {})", n);
+  }
+}
+
 static void test_fftshift(entier n)
 {
   soit x = linspace(0,n-1,n),
@@ -178,6 +204,165 @@ Vecteur<T> tfd(const Vecteur<T> &x, bouléen inv = non)
 }
 
 
+// Vérification de l'algorithme à base mixte (et comparaison avec l'ancienne implémentation)
+static void test_fft_mixte()
+{
+  msg_majeur("Tests FFT base mixte...");
+
+  pour(auto n: {6, 9, 12, 15, 20, 25, 35, 49, 60, 98, 210, 1200, 1536, 3000})
+  {
+    soit x    = Veccf::random(n);
+    soit plan = tfrplan_création(n);
+    soit X    = plan->step(x),
+         xi   = plan->step(x, non);
+
+    soit err1 = abs(X - tfd(x)).valeur_max(),
+         err2 = abs(xi - tfd(x, oui)).valeur_max();
+
+    tfr_radix_mixte = non;
+    soit X2   = tfrplan_création(n)->step(x);
+    tfr_radix_mixte = oui;
+    soit err3 = abs(X - X2).valeur_max();
+
+    msg("  n = {} : erreur fft = {:e}, ifft = {:e}, écart ancienne implémentation = {:e}", n, err1, err2, err3);
+    // (l'ancienne implémentation, via CZT, est nettement moins précise)
+    assertion_msg((err1 < 1e-5) && (err2 < 1e-5) && (err3 < 1e-3), "Erreur FFT base mixte (n = {})", n);
+  }
+}
+
+// Vérification des papillons vectorisés (comparaison avec la version scalaire)
+static void test_fft_simd()
+{
+  msg_majeur("Tests FFT radix 2 vectorisée (niveau SIMD détecté : {})...", tfr_simd_niveau());
+
+  soit niveau_max = tfr_simd_max;
+  pour(auto n: {2, 4, 8, 16, 32, 64, 1024, 4096})
+  {
+    soit x = Veccf::random(n);
+
+    tfr_simd_max = 0;
+    soit plan = tfrplan_création(n);
+    soit X0 = plan->step(x),
+         x0 = plan->step(x, non);
+
+    pour(auto niveau = 1; niveau <= niveau_max; niveau++)
+    {
+      tfr_simd_max = niveau;
+      soit X = plan->step(x),
+           xi = plan->step(x, non);
+      soit err1 = abs(X - X0).valeur_max(),
+           err2 = abs(xi - x0).valeur_max();
+      msg("  n = {}, niveau = {} : écart fft = {:e}, ifft = {:e}", n, tfr_simd_niveau(), err1, err2);
+      assertion_msg((err1 < 1e-5) && (err2 < 1e-5), "Erreur FFT vectorisée (n = {})", n);
+    }
+    tfr_simd_max = niveau_max;
+
+    soit err = abs(X0 - tfd(x)).valeur_max();
+    assertion_msg(err < 1e-4, "Erreur FFT scalaire (n = {})", n);
+  }
+}
+
+// Cache des tables de TFR : statistiques, éviction, utilisation concurrente
+static void test_fft_cache()
+{
+  msg_majeur("Tests cache des tables FFT...");
+
+  tfr_cache_vide();
+  soit x = Veccf::random(1000);
+  soit X1 = tfrplan_création(1000)->step(x);
+  soit s1 = tfr_cache_stats();
+  soit X2 = tfrplan_création(1000)->step(x);
+  soit s2 = tfr_cache_stats();
+  msg("  succès = {}, défauts = {}, entrées = {}, octets = {}", s2.nb_succès, s2.nb_défauts, s2.nb_entrées, s2.octets);
+  assertion_msg(s2.nb_défauts == s1.nb_défauts, "Cache FFT : tables recalculées");
+  assertion_msg(s2.nb_succès > s1.nb_succès, "Cache FFT : pas de succès");
+  assertion_msg(abs(X1 - X2).valeur_max() == 0, "Cache FFT : résultats différents");
+
+  // Fonctions libres : pas de recalcul des tables pour une dimension déjà vue
+  soit x3 = Veccf::random(1001);
+  soit X3 = fft(x3);
+  soit s3 = tfr_cache_stats();
+  pour(auto i = 0; i < 10; i++)
+    X3 = fft(x3);
+  assertion_msg(tfr_cache_stats().nb_défauts == s3.nb_défauts, "Cache FFT : tables recalculées (fft)");
+  soit err3 = abs(ifft(X3) - x3).valeur_max();
+  msg("  n = 1001 (CZT) : erreur fft / ifft = {:e}", err3);
+  assertion_msg(err3 < 1e-3, "Cache FFT : erreur ifft");
+
+  // Limite mémoire
+  tfr_cache_config(0);
+  soit s4 = tfr_cache_stats();
+  msg("  après limite : entrées = {}, évictions = {}", s4.nb_entrées, s4.nb_évictions);
+  assertion_msg((s4.nb_entrées == 0) && (s4.octets == 0) && (s4.nb_évictions > 0), "Cache FFT : éviction");
+  soit X5 = tfrplan_création(1000)->step(x);
+  assertion_msg(abs(X5 - X1).valeur_max() == 0, "Cache FFT : résultats différents après éviction");
+  tfr_cache_config(64 * 1024 * 1024);
+
+  // Plusieurs threads, plusieurs dimensions
+  vector<entier> dims = {64, 100, 127, 1000, 1024, 3000};
+  vector<Veccf> xs, Xs;
+  pour(auto n: dims)
+  {
+    xs.push_back(Veccf::random(n));
+    Xs.push_back(fft(xs.back()));
+  }
+  tfr_cache_vide();
+  std::atomic<entier> nb_erreurs{0};
+  vector<std::thread> threads;
+  pour(auto t = 0; t < 8; t++)
+  {
+    threads.push_back(std::thread([&, t]()
+    {
+      pour(auto k = 0; k < 50; k++)
+      {
+        soit i = (t + k) % dims.size();
+        si(abs(fft(xs[i]) - Xs[i]).valeur_max() > 1e-5)
+          nb_erreurs++;
+      }
+    }));
+  }
+  pour(auto &th: threads)
+    th.join();
+  soit s6 = tfr_cache_stats();
+  msg("  multi-threads : succès = {}, défauts = {}, entrées = {}", s6.nb_succès, s6.nb_défauts, s6.nb_entrées);
+  assertion_msg(nb_erreurs == 0, "Cache FFT : erreur en multi-threads");
+  assertion_msg(s6.nb_entrées == (entier) dims.size(), "Cache FFT : nombre d'entrées invalide");
+}
+
+// Calcul par lots (colonnes / lignes, en place), comparaison avec le calcul signal par signal
+static void test_fft_lots()
+{
+  msg_majeur("Tests FFT par lots...");
+
+  pour(auto n: {1, 8, 60, 64, 127, 1000, 1024})
+  {
+    pour(auto m: {1, 5, 37})
+    {
+      soit plan = tfrplan_création(n);
+      soit X  = Tabcf::random(n, m);
+      soit Xt = X.transpose();
+      pour(auto avant: {oui, non})
+      {
+        Tabcf Y, Yt, Z = X;
+        plan->step_batch(X, Y, 0, avant);
+        plan->step_batch(Xt, Yt, 1, avant);
+        plan->step_batch(Z, Z, 0, avant);
+
+        float err = 0;
+        pour(auto k = 0; k < m; k++)
+        {
+          soit ref = plan->step(X.col(k), avant);
+          err = max(err, abs(Y.col(k) - ref).valeur_max());
+          err = max(err, abs(Yt.row(k) - ref).valeur_max());
+          err = max(err, abs(Z.col(k) - ref).valeur_max());
+        }
+        msg("  n = {}, m = {}, avant = {} : écart = {:e}", n, m, avant, err);
+        assertion_msg(err < 1e-5, "Erreur FFT par lots (n = {}, m = {})", n, m);
+      }
+    }
+  }
+}
+
 template<typename Tin, typename Tout>
 static void test_fft_valide(entier n, bouléen alea, bouléen inv)
 {
@@ -698,8 +883,13 @@ void test_fourier()
   pour(auto n: {3, 4, 5, 63, 64, 511, 512, 1000, 1001})
     test_csym(n);
 
+  test_fft_mixte();
+  test_fft_simd();
+  test_fft_cache();
+  test_fft_lots();
   test_fftplan();
   test_rfftplan();
+  test_irfftplan();
   test_goertzel();
 
   test_reechan();
@@ -742,3 +932,102 @@ void test_fourier()
 }
 
 
+
+
+// Banc de mesure : base mixte / ancienne implémentation (décomposition paire + CZT),
+// pour toutes les dimensions de la forme 2^a 3^b 5^c 7^d (hors puissances de 2) jusqu'à 65536.
+void bench_fft()
+{
+  using horloge = std::chrono::steady_clock;
+
+  soit mesure = [](entier n, bouléen mixte)
+  {
+    tfr_radix_mixte = mixte;
+    soit plan = tfrplan_création(n);
+    tfr_radix_mixte = oui;
+    soit x = Veccf::random(n);
+    Veccf y;
+    soit nitr = max(1, 200000 / n);
+    plan->step(x, y);
+    soit t0 = horloge::now();
+    pour(auto i = 0; i < nitr; i++)
+      plan->step(x, y);
+    soit t1 = horloge::now();
+    retourne std::chrono::duration<double, std::micro>(t1 - t0).count() / nitr;
+  };
+
+  vector<float> dims, gains;
+  pour(auto n = 2; n <= 65536; n++)
+  {
+    soit m = n;
+    pour(auto p: {2, 3, 5, 7})
+      tantque((m % p) == 0)
+        m /= p;
+    si((m != 1) || ((n & (n - 1)) == 0))
+      continue;
+
+    soit t_mixte = mesure(n, oui),
+         t_ref   = mesure(n, non);
+    dims.push_back(n);
+    gains.push_back(t_ref / t_mixte);
+    msg("n = {:5d} : base mixte = {:8.2f} µs, ancienne = {:8.2f} µs, gain = {:.2f}", n, t_mixte, t_ref, t_ref / t_mixte);
+  }
+
+  pour(auto n = 64; n <= 65536; n *= 2)
+  {
+    soit x    = Veccf::random(n);
+    soit plan = tfrplan_création(n);
+    Veccf y;
+    soit nitr = max(1, 2000000 / n);
+    soit niveau_max = tfr_simd_max;
+    soit mesure_radix2 = [&]()
+    {
+      plan->step(x, y);
+      soit t0 = horloge::now();
+      pour(auto i = 0; i < nitr; i++)
+        plan->step(x, y);
+      soit t1 = horloge::now();
+      retourne std::chrono::duration<double, std::micro>(t1 - t0).count() / nitr;
+    };
+    tfr_simd_max = 0;
+    soit t_scalaire = mesure_radix2();
+    tfr_simd_max = niveau_max;
+    soit t_simd = mesure_radix2();
+    msg("radix 2, n = {:5d} : scalaire = {:8.2f} µs, SIMD (niveau {}) = {:8.2f} µs, gain = {:.2f}",
+        n, t_scalaire, tfr_simd_niveau(), t_simd, t_scalaire / t_simd);
+  }
+
+  pour(auto n: {64, 256, 1000, 1024})
+  {
+    soit m    = 512;
+    soit plan = tfrplan_création(n);
+    soit X    = Tabcf::random(n, m);
+    Tabcf Y(n, m);
+    Veccf y;
+    soit nitr = max(1, 20000000 / (n * m));
+
+    plan->step_batch(X, Y);
+    soit t0 = horloge::now();
+    pour(auto i = 0; i < nitr; i++)
+      plan->step_batch(X, Y);
+    soit t1 = horloge::now();
+    pour(auto i = 0; i < nitr; i++)
+      pour(auto k = 0; k < m; k++)
+        Y.col(k) = plan->step(X.col(k));
+    soit t2 = horloge::now();
+    soit t_lot    = std::chrono::duration<double, std::micro>(t1 - t0).count() / nitr,
+         t_boucle = std::chrono::duration<double, std::micro>(t2 - t1).count() / nitr;
+    msg("lots, n = {:5d}, m = {} : step_batch = {:8.2f} µs, boucle = {:8.2f} µs, gain = {:.2f}",
+        n, m, t_lot, t_boucle, t_boucle / t_lot);
+  }
+
+  soit g = Vecf::map(gains.data(), gains.size());
+  msg_majeur("Gain moyen = {:.2f}, gain min = {:.2f}, gain max = {:.2f}", g.moyenne(), g.valeur_min(), g.valeur_max());
+
+  si(tests_debug_actif)
+  {
+    Figure f;
+    f.plot(Vecf::map(dims.data(), dims.size()), g, "b.", "Gain base mixte");
+    f.afficher("bench-fft");
+  }
+}
@@ -1,5 +1,6 @@
 #include "tsd/tsd-all.hpp"
 #include "tsd/tests.hpp"
+#include <chrono>
 
 
 void test_itrp_irreg()
@@ -56,6 +57,59 @@ void test_itrp_retard()
 }
 
 
+// Farrow : écart avec le sinus cardinal fenêtré (calculé sans quantification du retard),
+// step() VS coefs_into(), et performances VS table de phases.
+void test_itrp_farrow()
+{
+  msg_majeur("Test interpolateur de Farrow...");
+
+  pour(auto [D, tol]: {std::pair{3, 2e-2f}, {5, 2e-3f}})
+  {
+    soit K = 15;
+    soit farrow = itrp_farrow<cfloat>({K, D, 0.45, "hn"});
+    // τ = i / 64 : index exact dans la table
+    soit sinc   = itrp_sinc<cfloat>({K, 64, 0.45, "hn"});
+
+    soit err = 0.0f;
+    pour(auto i = 0; i <= 64; i++)
+      err = max(err, abs(farrow->coefs(i / 64.0f) - sinc->coefs(i / 64.0f)).valeur_max());
+    msg("Farrow degré {} : écart max avec sinc = {:.2e}", D, err);
+    assertion_msg(err < tol, "Farrow degré {} : écart trop important ({}).", D, err);
+
+    // Fenêtre circulaire, index de départ quelconque
+    Veccf x = randn(K) + ⅈ * randn(K);
+    pour(auto k = 0; k < K; k += 4)
+    {
+      pour(auto τ: {0.0f, 0.123f, 0.5f, 0.999f, 1.0f})
+      {
+        Vecf h(K);
+        farrow->coefs_into(τ, h.data());
+        cfloat yref = 0;
+        pour(auto i = 0; i < K; i++)
+          yref += h(i) * x((i + k) % K);
+        soit y = farrow->step(x, k, τ);
+        assertion_msg(abs(y - yref) < 1e-4f, "Farrow : step() incohérent ({} vs {}).", y, yref);
+      }
+    }
+  }
+
+  // Performances (appel par échantillon, comme dans la récupération d'horloge)
+  soit n = 200000;
+  Veccf x = randn(15) + ⅈ * randn(15);
+  pour(auto farrow: {oui, non})
+  {
+    sptr<InterpolateurRIF<cfloat>> itrp = farrow ? itrp_farrow<cfloat>({15, 5, 0.45, "hn"})
+                                                 : itrp_sinc<cfloat>({15, 256, 0.45, "hn"});
+    cfloat acc = 0;
+    soit t0 = std::chrono::steady_clock::now();
+    pour(auto i = 0; i < n; i++)
+      acc += itrp->step(x, i % 15, (i % 1000) * 1e-3f);
+    soit t1 = std::chrono::steady_clock::now();
+    soit t  = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    msg("{} : {:.1f} ns / échantillon (somme = {}).", itrp->nom, t, acc);
+  }
+}
+
 void test_itrp()
 {
   msg_majeur("Test des interpolateurs...");
@@ -84,6 +138,10 @@ void test_itrp()
 
         itrp_sinc<cfloat>({31, 256, 0.48, "hn"}),
         itrp_sinc<cfloat>({63, 256, 0.48, "hn"}),
+
+        itrp_farrow<cfloat>({15, 3, 0.5, "hn"}),
+        itrp_farrow<cfloat>({15, 5, 0.45, "hn"}),
+        itrp_farrow<cfloat>({31, 5, 0.45, "re"}),
     };
 
   pour(auto itrp: itrps)
@@ -96,6 +154,11 @@ void test_itrp()
     {
       soit cl = Couleur{255*δ,0,255*(1-δ)};
       soit h  = itrp->coefs(δ);
+
+      // coefs_into() : mêmes coefficients que coefs()
+      Vecf h2(itrp->K);
+      itrp->coefs_into(δ, h2.data());
+      assertion_msg(abs(h - h2).valeur_max() == 0, "Interpolateur {} : coefs_into() != coefs().", itrp->nom);
       soit c  = f.plot(h, "b-o", "Délais = {:.1f}", δ);
       c.def_couleur(cl);
 
@@ -113,4 +176,5 @@ void test_itrp()
   }
 
   test_itrp_retard();
+  test_itrp_farrow();
 }
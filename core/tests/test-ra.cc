@@ -1,5 +1,6 @@
 #include "tsd/tsd-all.hpp"
 #include "tsd/tests.hpp"
+#include <chrono>
 
 
 struct ResultatPurete
@@ -166,12 +167,104 @@ static void test_ra_unit(float ratio)
 
 
 
+// Demi-bande (décimation et interpolation), par bloc, VS références directes
+template<typename T>
+static void test_demi_bande_bloc(const Vecf &h)
+{
+  soit K  = h.rows();
+  soit fd = filtre_rif_demi_bande<float, T>(h);
+  soit fu = filtre_rif_demi_bande_ups<float, T>(h);
+
+  Vecteur<T> xtot, yd, yu;
+  pour(auto n: {1, 5, 64, 100, 333, 1000, 2})
+  {
+    Vecteur<T> x = randn(n).template as<T>();
+    si constexpr(est_complexe<T>())
+      x += ⅈ * randn(n);
+    xtot = xtot | x;
+    yd = yd | fd->step(x);
+    yu = yu | fu->step(x);
+  }
+  soit n = xtot.rows();
+
+  // Décimation (même convention que filtre_rif_decim()) : y_j = somme_i h_i x_{t - K + 1 + i}, t = 1 + 2j
+  Vecteur<T> ydref(n / 2);
+  pour(auto j = 0; j < ydref.rows(); j++)
+  {
+    soit t = 1 + 2 * j;
+    T s = 0;
+    pour(auto i = 0; i < K; i++)
+      si(t - K + 1 + i >= 0)
+        s += h(i) * xtot(t - K + 1 + i);
+    ydref(j) = s;
+  }
+
+  // Interpolation : y_t = somme_k 2 h_k x'_{t-k}, x' : un zéro inséré après chaque échantillon
+  Vecteur<T> yuref(2 * n);
+  pour(auto t = 0; t < 2 * n; t++)
+  {
+    T s = 0;
+    pour(auto k = 0; k < K; k++)
+      si((t - k >= 0) && (((t - k) % 2) == 0))
+        s += 2 * h(k) * xtot((t - k) / 2);
+    yuref(t) = s;
+  }
+
+  assertion((yd.rows() == ydref.rows()) && (yu.rows() == yuref.rows()));
+  soit errd = abs(yd - ydref).valeur_max(),
+       erru = abs(yu - yuref).valeur_max();
+  msg("Demi-bande K = {} : erreur décimation = {}, interpolation = {}", K, errd, erru);
+  assertion_msg((errd < 1e-5f) && (erru < 1e-5f), "Demi-bande K = {} : erreurs = {}, {}", K, errd, erru);
+}
+
 static void test_filtre_rif_demi_bande()
 {
   msg_majeur("Test filtre_rif_demi_bande");
   soit h = design_rif_fen(15, "lp", 0.25, "hn");
   soit ra = filtre_rif_demi_bande<float,float>(h);
   test_ra_unit("rif demi-bande", 0.5, ra);
+  test_ra_unit("rif demi-bande ups", 2, filtre_rif_demi_bande_ups<float,float>(h));
+
+  // (m = (n-1)/2 impair, puis pair : zéros en bout de filtre)
+  pour(auto hb: {h, design_rif_demi_bande(23, 0.2), design_rif_demi_bande(21, 0.2), design_rif_demi_bande(3, 0.1)})
+  {
+    test_demi_bande_bloc<float>(hb);
+    test_demi_bande_bloc<cfloat>(hb);
+  }
+
+  // Cascade : les étages rapides ont moins de coefficients
+  soit designs = design_rif_demi_bande_cascade(3, 0.2, 60);
+  msg("Cascade demi-bande /8 : {} / {} / {} coefficients.", designs[0].rows(), designs[1].rows(), designs[2].rows());
+  assertion((designs[0].rows() <= designs[1].rows()) && (designs[1].rows() <= designs[2].rows()));
+  test_ra_unit("cascade demi-bande /8", 1.0f / 8, filtre_rif_demi_bande_cascade<float>(3, 0.2));
+  test_ra_unit("cascade demi-bande x8", 8, filtre_rif_demi_bande_cascade<float>(3, 0.2, 60, oui));
+
+  // Performances : demi-bande VS RIF polyphase générique (mêmes coefficients)
+  soit hp = design_rif_demi_bande(31, 0.2);
+  soit n  = 64 * 1024;
+  Veccf x = randn(n) + ⅈ * randn(n);
+  pour(auto i = 0; i < 4; i++)
+  {
+    sptr<FiltreGen<cfloat>> f;
+    si(i == 0)
+      f = filtre_rif_demi_bande<float, cfloat>(hp);
+    sinon si(i == 1)
+      f = filtre_rif_decim<float, cfloat>(hp, 2);
+    sinon si(i == 2)
+      f = filtre_rif_demi_bande_ups<float, cfloat>(hp);
+    sinon
+      f = filtre_rif_ups<float, cfloat>(hp, 2);
+    Veccf y;
+    f->step(x, y);
+    soit t0 = std::chrono::steady_clock::now();
+    pour(auto k = 0; k < 10; k++)
+      f->step(x, y);
+    soit t1 = std::chrono::steady_clock::now();
+    soit t  = std::chrono::duration<double, std::milli>(t1 - t0).count() / 10;
+    msg("K = 31, {} : {:.2f} ms pour {} échantillons ({:.1f} Méch/s).",
+        (i == 0) ? "demi-bande /2" : (i == 1) ? "rif_decim /2" : (i == 2) ? "demi-bande x2" : "rif_ups x2",
+        t, n, n / (t * 1e3));
+  }
 }
 
 
@@ -186,10 +279,83 @@ static void test_filtre_rif_decim(entier R)
   test_ra_unit("rif decim", 1.0/R, ra);
 }
 
+// Décimateur polyphase (par bloc, avec ou sans repliement des coefficients)
+// VS filtrage direct suivi d'une décimation.
+// forme : 0 = coefficients quelconques, 1 = symétriques, -1 = anti-symétriques
+template<typename T>
+static void test_filtre_rif_decim_bloc(entier R, entier K, entier forme)
+{
+  Vecf h = design_rif_fen(K, "lp", 0.4/R, "hn");
+  si(forme == 0)
+    h *= linspace(1, 2, K);
+  sinon si(forme < 0)
+    h -= h.reverse().clone();
+
+  soit f = filtre_rif_decim<float, T>(h, R);
+
+  Vecteur<T> xtot, ytot;
+  pour(auto n: {1, 5, 64, 100, 333, 1000})
+  {
+    Vecteur<T> x = randn(n).template as<T>();
+    si constexpr(est_complexe<T>())
+      x += ⅈ * randn(n);
+    xtot = xtot | x;
+    ytot = ytot | f->step(x);
+  }
+
+  // y_j = somme_i h_i x_{t - K + 1 + i}, t = R - 1 + R.j
+  soit n = xtot.rows();
+  Vecteur<T> yref(n / R);
+  pour(auto j = 0; j < yref.rows(); j++)
+  {
+    soit t = R - 1 + R * j;
+    T s = 0;
+    pour(auto i = 0; i < K; i++)
+      si(t - K + 1 + i >= 0)
+        s += h(i) * xtot(t - K + 1 + i);
+    yref(j) = s;
+  }
+  assertion(ytot.rows() == yref.rows());
+  soit err = abs(ytot - yref).valeur_max();
+  assertion_msg(err < 1e-5f, "RIF décim (R = {}, K = {}, forme = {}) : erreur = {}", R, K, forme, err);
+}
+
 static void test_filtre_rif_decim()
 {
   pour(auto R: {2, 3, 4, 5, 8})
     test_filtre_rif_decim(R);
+
+  msg_majeur("Test filtre_rif_decim : traitement par bloc");
+  pour(auto R: {1, 2, 3, 4, 5, 8})
+  {
+    pour(auto K: {3, 7, 15, 16, 31, 64})
+    {
+      pour(auto forme: {0, 1, -1})
+      {
+        test_filtre_rif_decim_bloc<float>(R, K, forme);
+        test_filtre_rif_decim_bloc<cfloat>(R, K, forme);
+      }
+    }
+  }
+
+  // Performances (R = 4, 127 coefficients)
+  pour(auto sym: {oui, non})
+  {
+    soit R  = 4, n = 64 * 1024;
+    soit h  = design_rif_fen(127, "lp", 0.5/R);
+    si(!sym)
+      h(0) *= 1.001f;
+    soit f  = filtre_rif_decim<float, cfloat>(h, R);
+    Veccf x = randn(n) + ⅈ * randn(n), y;
+    f->step(x, y);
+    soit t0 = std::chrono::steady_clock::now();
+    pour(auto i = 0; i < 10; i++)
+      f->step(x, y);
+    soit t1 = std::chrono::steady_clock::now();
+    soit t  = std::chrono::duration<double, std::milli>(t1 - t0).count() / 10;
+    msg("RIF décim R = {}, K = 127, {} : {:.2f} ms pour {} échantillons ({:.1f} Méch/s).",
+        R, sym ? "symétrique" : "quelconque", t, n, n / (t * 1e3));
+  }
 }
 
 void test_filtre_rif_ups()
@@ -202,6 +368,85 @@ void test_filtre_rif_ups()
 
 
 
+// Ré-échantillonnage rationnel : traitement par blocs VS référence (sur-échantillonnage, filtrage, décimation)
+template<typename T>
+static void test_reechan_rationnel_bloc(entier L, entier M)
+{
+  soit f = filtre_reechan_rationnel<T>(L, M);
+
+  Vecteur<T> xtot, ytot;
+  pour(auto n: {1, 7, 64, 100, 333, 1000, 2})
+  {
+    Vecteur<T> x = randn(n).template as<T>();
+    si constexpr(est_complexe<T>())
+      x += ⅈ * randn(n);
+    xtot = xtot | x;
+    ytot = ytot | f->step(x);
+  }
+
+  soit P = max(L, M);
+  Vecf h = design_rif_fen_kaiser("lp", 0.45f / P, 60, 0.1f / P) * L;
+  soit K = h.rows(), n = xtot.rows();
+
+  // y_j = somme_i h_i xup_{j.M - i}, xup : x avec L - 1 zéros insérés
+  Vecteur<T> yref((n * L + M - 1) / M);
+  pour(auto j = 0; j < yref.rows(); j++)
+  {
+    T s = 0;
+    pour(auto i = 0; i < K; i++)
+    {
+      soit u = j * M - i;
+      si((u >= 0) && (u % L == 0))
+        s += h(i) * xtot(u / L);
+    }
+    yref(j) = s;
+  }
+  assertion_msg(ytot.rows() == yref.rows(), "Rééchan rationnel {}/{} : {} sorties (attendu : {}).",
+                L, M, ytot.rows(), yref.rows());
+  soit err = abs(ytot - yref).valeur_max();
+  msg("Rééchan rationnel {}/{} (K = {}) : erreur max = {}", L, M, K, err);
+  assertion_msg(err < 1e-4f, "Rééchan rationnel {}/{} : erreur = {}", L, M, err);
+}
+
+static void test_reechan_rationnel()
+{
+  msg_majeur("Test filtre_reechan_rationnel");
+  pour(auto [L, M]: {std::pair{3, 2}, {2, 3}, {147, 160}, {160, 147}, {1, 3}, {5, 1}})
+  {
+    test_reechan_rationnel_bloc<float>(L, M);
+    test_reechan_rationnel_bloc<cfloat>(L, M);
+    test_ra_unit(format("rationnel {}/{}", L, M), ((float) L) / M, filtre_reechan_rationnel<float>(L, M));
+  }
+
+  // Les designs sont mémorisés
+  pour(auto essai = 0; essai < 2; essai++)
+  {
+    soit t0 = std::chrono::steady_clock::now();
+    soit f  = filtre_reechan_rationnel<float>(160, 147, 80);
+    soit t1 = std::chrono::steady_clock::now();
+    msg("Création filtre 160/147 (essai {}) : {:.3f} ms.", essai,
+        std::chrono::duration<double, std::milli>(t1 - t0).count());
+  }
+
+  // Performances, 48 kHz -> 44,1 kHz
+  soit n = 1024 * 1024;
+  Vecf x = randn(n), y;
+  pour(auto rationnel: {oui, non})
+  {
+    sptr<FiltreGen<float>> f = rationnel ? filtre_reechan_rationnel<float>(147, 160)
+                                         : filtre_itrp<float>(147.0f / 160, itrp_sinc<float>({15, 256, 0.4, "hn"}));
+    f->step(x, y);
+    soit t0 = std::chrono::steady_clock::now();
+    f->step(x, y);
+    soit t1 = std::chrono::steady_clock::now();
+    soit t  = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    msg("Rééchan 147/160, {} : {:.2f} ms pour {} échantillons ({:.1f} Méch/s).",
+        rationnel ? "polyphase rationnel" : "interpolateur sinc", t, n, n / (t * 1e3));
+  }
+}
+
+
+
 
 
 void test_ra()
@@ -210,9 +455,10 @@ void test_ra()
   test_filtre_rif_ups();
 
   test_filtre_rif_demi_bande();
+  test_reechan_rationnel();
 
   //soit ratios = ;
-  pour(auto ratio: {1.f, 1.5f, 0.5f, 2.f, 1.2f, π_f})
+  pour(auto ratio: {1.f, 1.5f, 0.5f, 2.f, 1.2f, 147.f / 160, π_f})
     test_ra_unit(ratio);
 }
 
@@ -330,6 +330,105 @@ void test_tab()
     assertion((A.rows() == 2) && (A.cols() == 3)
                && (A(0,0) == 0) && (A(1,0) == 3));
   }
+
+  {
+    msg("Evaluation paresseuse...");
+    soit n = 1001;
+    Veccf z = randn(n) + ⅈ * randn(n);
+    Vecf  a = randn(n), b = abs(randn(n)) + 0.1f;
+
+    // Doit être identique bit à bit au calcul immédiat
+    soit identique = [](const Vecf &x, const Vecf &y)
+    {
+      retourne (x.rows() == y.rows()) && (memcmp(x.data(), y.data(), x.rows() * sizeof(float)) == 0);
+    };
+
+    Vecf r1 = 0.5f * abs2(z) / (b + 1e-20f);
+    Vecf r2 = 0.5f * abs2(paresseux(z)) / (paresseux(b) + 1e-20f);
+    assertion(identique(r1, r2));
+
+    r1 = 2.0f - a * b + square(a) - 3.0f / b;
+    r2 = 2.0f - paresseux(a) * b + square(paresseux(a)) - 3.0f / paresseux(b);
+    assertion(identique(r1, r2));
+
+    r1 = abs(z * z.conjugate() + a) - real(z) * imag(z);
+    r2 = abs(paresseux(z) * conj(paresseux(z)) + a) - real(paresseux(z)) * imag(paresseux(z));
+    assertion(identique(r1, r2));
+
+    // Affectation en place : pas de réallocation si mêmes dimensions
+    soit ptr = r2.data();
+    r2 = -paresseux(r2) * 2.0f;
+    assertion(r2.data() == ptr);
+    assertion(identique(r2, -r1 * 2.0f));
+
+    msg("Fait.");
+  }
+
+  {
+    msg("Allocateur / zone temporaire...");
+    soit h = design_rif_fen(31, "lp", 0.1);
+    soit f = filtre_rif<float, float>(h);
+    Vecf x = randn(256), sortie;
+
+    // Régime établi : plus aucun appel au tas global
+    pour(auto i = 0; i < 104; i++)
+    {
+      si(i == 4)
+        tab_alloc_stats_raz();
+      ScopeScratch scratch;
+      Vecf y = f->step(x);
+      sortie = y * 2.0f + 1.0f;
+    }
+    soit stats = tab_alloc_stats();
+    msg("Allocations : {} (tas : {}, recyclages : {}, zone temporaire : {}).",
+        stats.nb_allocations, stats.nb_allocations_tas, stats.nb_recyclages, stats.nb_scratch);
+    assertion(stats.nb_allocations > 0);
+    assertion(stats.nb_allocations_tas == 0);
+
+    // Un tableau sortant de la zone temporaire reste valide
+    Vecf ref = f->step(x) * 2.0f + 1.0f;
+    sortie = f->step(x) * 2.0f + 1.0f;
+    pour(auto i = 0; i < 10; i++)
+    {
+      ScopeScratch scratch;
+      Vecf tmp = Vecf::ones(1000) * 5.0f;
+    }
+    assertion(sortie.est_approx(ref));
+
+    // Pools seuls
+    tab_alloc_stats_raz();
+    pour(auto i = 0; i < 100; i++)
+      sortie = f->step(x) + 1.0f;
+    stats = tab_alloc_stats();
+    assertion(stats.nb_allocations_tas == 0);
+    assertion(stats.nb_recyclages > 0);
+    msg("Fait.");
+  }
+
+  {
+    msg("Alignement...");
+    pour(auto n: {1, 3, 16, 17, 1000})
+    {
+      Vecf x(n);
+      Veccd y(n);
+      assertion(x.est_aligné() && y.est_aligné());
+      assertion((((uintptr_t) x.data()) % TAB_ALIGNEMENT) == 0);
+      {
+        ScopeScratch scratch;
+        Tabf z(n, 3);
+        assertion(z.est_aligné());
+      }
+    }
+    Vecf x(100);
+    assertion(x.segment(16, 32).est_aligné());
+    assertion(!x.segment(1, 32).est_aligné());
+
+    alignas(64) float buf[64];
+    assertion(!Vecf::map(buf, 64).est_aligné());
+    assertion(Vecf::map(buf, 60, 1, 64).est_aligné());
+    assertion(!Vecf::map(buf + 1, 60, 1, 64).est_aligné());
+    msg("Fait.");
+  }
 }
 
 
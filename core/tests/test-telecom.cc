@@ -1,5 +1,6 @@
 #include "tsd/tsd-all.hpp"
 #include "tsd/tests.hpp"
+#include <chrono>
 
 
 static void test_filtre_boucle_ordre_1()
@@ -1176,6 +1177,187 @@ static void test_émetteur()
   msg("ok.");
 }
 
+// Sorties du canaliseur, pour des blocs d'entrée de dimensions irrégulières
+static Tabcf pfb_analyse_blocs(sptr<CanaliseurPFB> c, const Veccf &x)
+{
+  soit n = x.rows();
+  vector<Tabcf> blocs;
+  entier nb = 0, i = 0, k = 0;
+  tantque(i < n)
+  {
+    soit d = min(n - i, (entier) (1 + (k++ * 37) % 211));
+    blocs.push_back(c->step(x.segment(i, d)));
+    nb += blocs.back().rows();
+    i += d;
+  }
+  Tabcf Y(nb, blocs[0].cols());
+  entier l = 0;
+  pour(auto &b: blocs)
+  {
+    pour(auto j = 0; j < b.rows(); j++)
+      pour(auto k = 0; k < b.cols(); k++)
+        Y(l + j, k) = b(j, k);
+    l += b.rows();
+  }
+  retourne Y;
+}
+
+static void test_canaliseur_pfb(entier M, entier osf)
+{
+  CanaliseurPFBConfig config;
+  config.nb_canaux           = M;
+  config.sur_échantillonnage = osf;
+  soit R = M / osf;
+  // Même prototype que celui calculé par défaut
+  soit h = design_rif_fen_kaiser("lp", 0.5f / M, 60, (osf == 1 ? 0.2f : 0.5f) / M);
+  h /= h.somme();
+  soit K = h.rows(), D = K - R;
+
+  msg("Canaliseur PFB : M = {}, R = {}, K = {}...", M, R, K);
+
+  // Analyse : comparaison avec le calcul direct
+  {
+    soit n = 40 * M + 17;
+    Veccf x = randn(n) + ⅈ * randn(n);
+    soit Y = pfb_analyse_blocs(canaliseur_pfb(config), x);
+    soit nb = Y.rows();
+    assertion_msg(nb == n / R, "Canaliseur PFB : nombre de sorties invalide ({}, attendu : {}).", nb, n / R);
+    assertion(Y.cols() == M);
+
+    double err = 0, ref = 0;
+    pour(auto m = 0; m < nb; m += 3)
+    {
+      soit t = m * R + R - 1;
+      pour(auto k = 0; k < M; k += max(1, M / 8))
+      {
+        std::complex<double> s = 0;
+        pour(auto i = 0; (i < K) && (i <= t); i++)
+          s += (double) h(i) * std::complex<double>(x(t - i))
+             * std::polar(1.0, -2 * π * ((k * (t - i)) % M) / M);
+        err = max(err, abs(std::complex<double>(Y(m, k)) - s));
+        ref = max(ref, abs(s));
+      }
+    }
+    msg("  analyse : erreur max = {:e} (amplitude max : {:.2f}).", err, ref);
+    assertion_msg(err < 1e-4 * ref, "Canaliseur PFB : erreur d'analyse trop importante ({}).", err);
+  }
+
+  // Isolation : raie au voisinage du centre du canal k0
+  {
+    soit k0 = M / 3;
+    soit n = 200 * M;
+    Veccf x(n);
+    pour(auto i = 0; i < n; i++)
+      x(i) = std::polar(1.0f, 2 * π_f * (((k0 * i) % M) + 0.1f * i) / M);
+    soit Y = canaliseur_pfb(config)->step(x);
+    soit n0 = Y.rows() / 2;
+    soit p0 = Y.col(k0).tail(n0).ms();
+    double pmax = 0;
+    pour(auto k = 0; k < M; k++)
+      si(abs(k - k0) > 1)
+        pmax = max(pmax, (double) Y.col(k).tail(n0).ms());
+    soit iso = 10 * log10(p0 / pmax);
+    msg("  isolation : {:.1f} dB (puissance canal {} : {:.4f}).", iso, k0, p0);
+    assertion_msg(iso > 55, "Canaliseur PFB : isolation insuffisante ({:.1f} dB).", iso);
+    assertion_msg(abs(p0 - 1) < 0.01, "Canaliseur PFB : gain du canal invalide ({}).", p0);
+  }
+
+  // Synthèse : comparaison avec le calcul direct
+  {
+    soit nb = 31, nb0 = 12;
+    Tabcf X(nb, M), X0(nb0, M), X1(nb - nb0, M);
+    pour(auto m = 0; m < nb; m++)
+    {
+      pour(auto k = 0; k < M; k++)
+      {
+        X(m, k) = cfloat(randn(), randn());
+        (m < nb0 ? X0(m, k) : X1(m - nb0, k)) = X(m, k);
+      }
+    }
+    soit s = synthétiseur_pfb(config);
+    soit y0 = s->step(X0);
+    soit y  = vconcat(y0, s->step(X1));
+    assertion(y.rows() == nb * R);
+
+    double err = 0, ref = 0;
+    pour(auto t = 0; t < nb * R; t += max(7, M / 16))
+    {
+      std::complex<double> v = 0;
+      pour(auto m = 0; m < nb; m++)
+      {
+        soit n = t - m * R;
+        si((n < 0) || (n >= K))
+          continue;
+        pour(auto k = 0; k < M; k++)
+          v += std::complex<double>(X(m, k)) * (double) (R * h(n))
+             * std::polar(1.0, 2 * π * (((k * (t - D)) % M + M) % M) / M);
+      }
+      err = max(err, abs(std::complex<double>(y(t)) - v));
+      ref = max(ref, abs(v));
+    }
+    msg("  synthèse : erreur max = {:e} (amplitude max : {:.2f}).", err, ref);
+    assertion_msg(err < 1e-4 * ref, "Canaliseur PFB : erreur de synthèse trop importante ({}).", err);
+  }
+
+  // Analyse puis synthèse : reconstitution du signal (retardé de D échantillons)
+  {
+    soit n = 300 * M;
+    Veccf x = Veccf::zeros(n);
+    pour(auto k: {1, M / 4, M / 2 + 1})
+      pour(auto i = 0; i < n; i++)
+        x(i) += std::polar(1.0f, 2 * π_f * (((k * i) % M) + 0.05f * i) / M);
+    soit Y = pfb_analyse_blocs(canaliseur_pfb(config), x);
+    soit y = synthétiseur_pfb(config)->step(Y);
+    soit i0 = 2 * K, m = y.rows() - i0;
+    soit err = sqrt((y.segment(i0, m) - x.segment(i0 - D, m)).ms() / x.segment(i0 - D, m).ms());
+    msg("  analyse / synthèse : erreur relative = {:e}.", err);
+    assertion_msg(err < 1e-2, "Canaliseur PFB : erreur de reconstitution trop importante ({}).", err);
+  }
+}
+
+static void bench_canaliseur_pfb()
+{
+  pour(auto osf: {1, 2})
+  {
+    CanaliseurPFBConfig config;
+    config.nb_canaux           = 256;
+    config.sur_échantillonnage = osf;
+    soit c = canaliseur_pfb(config);
+    soit s = synthétiseur_pfb(config);
+    soit n = 256 * 1024;
+    Veccf x = randn(n) + ⅈ * randn(n);
+    Tabcf Y;
+    Veccf y;
+    c->step(x, Y);
+    s->step(Y, y);
+    double ta = 1e30, ts = 1e30;
+    pour(auto essai = 0; essai < 5; essai++)
+    {
+      soit t0 = std::chrono::steady_clock::now();
+      c->step(x, Y);
+      soit t1 = std::chrono::steady_clock::now();
+      s->step(Y, y);
+      soit t2 = std::chrono::steady_clock::now();
+      ta = min(ta, std::chrono::duration<double, std::micro>(t1 - t0).count());
+      ts = min(ts, std::chrono::duration<double, std::micro>(t2 - t1).count());
+    }
+    msg("Canaliseur PFB, 256 canaux, sur-échantillonnage {} : analyse {:.1f} Méch/s, synthèse {:.1f} Méch/s.",
+        osf, n / ta, y.rows() / ts);
+  }
+}
+
+static void test_canalisation_pfb()
+{
+  msg_majeur("Test canaliseur / synthétiseur polyphase...");
+  pour(auto osf: {1, 2})
+  {
+    test_canaliseur_pfb(16, osf);
+    test_canaliseur_pfb(64, osf);
+  }
+  test_canaliseur_pfb(1024, 1);
+  bench_canaliseur_pfb();
+}
+
 void test_telecom()
 {
   test_filtre_boucle_ordre_1();
@@ -1185,4 +1367,5 @@ void test_telecom()
   test_fsk();
   test_demod();
   test_sah();
+  test_canalisation_pfb();
 }
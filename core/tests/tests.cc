@@ -10,7 +10,7 @@ extern test_routine_t test_detecteur, test_unites, test_filtre_fft, test_crec, t
   test_fenetres, test_tod, test_cqt, test_image, test_poly, test_stats, test_telecom, test_kalman,
   test_geometrie, test_date_heure, test_itrp, test_delais_filtres, test_filtre_adapte, test_formes_ondes,
   test_itrp_irreg, test_recepteur, bench_recepteur, test_motifs, test_bitstream,
-  test_filtrage_analyse, test_dsp, test_tab;
+  test_filtrage_analyse, test_dsp, test_tab, bench_fft;
 
 
 static vector<Test> tests =
@@ -20,6 +20,7 @@ static vector<Test> tests =
   {"dsp",               &test_dsp},
   {"bitstream",         &test_bitstream},
   {"fourier",           &test_fourier},
+  {"fourier-bench",     &bench_fft},
   {"date-heure",        &test_date_heure},
   {"geo",               &test_geometrie},
   {"fenetres",          &test_fenetres},